@@ -2,6 +2,24 @@ import type { MDBXDbiStat, MDBXEnvOpenOptions, MDBXKey } from "./types.js";
 
 type MDBXAsyncValue = Buffer | string;
 
+export interface MDBXAsyncEnvOptions {
+  /**
+   * `'message'` (default) sends commands with `postMessage`. `'ring'` uses two
+   * single-producer/single-consumer rings in a `SharedArrayBuffer` with a
+   * binary codec and `Atomics` wake-ups; messages larger than a ring still go
+   * through a `MessagePort` without breaking order.
+   */
+  transport?: "message" | "ring";
+  /** Bytes per ring, a power of two in [4096, 2^30]; 1 MiB by default. */
+  ringSize?: number;
+  /**
+   * Extra Workers that serve read transactions; `0` (default) keeps a single
+   * Worker for everything. Write transactions always run in the writer Worker,
+   * and each read transaction stays pinned to the Worker that started it.
+   */
+  readers?: number;
+}
+
 export interface MDBXAsyncMapOpenOptions {
   name?: string;
   keyMode?: number;
@@ -44,7 +62,11 @@ export declare class MDBX_Async_Dbi {
 
   forEach(cb: (key: MDBXKey, value: MDBXAsyncValue, index: number) => void): Promise<void>;
 
-  getBatch(keys: MDBXKey[]): Promise<MDBXAsyncGetBatchResultItem[]>;
+  /**
+   * Items are plain objects; with `lazy: true` each item decodes `value`
+   * from the packed reply on first access.
+   */
+  getBatch(keys: MDBXKey[], options?: { lazy?: boolean }): Promise<MDBXAsyncGetBatchResultItem[]>;
   putBatch(items: Array<{ key: MDBXKey; value: MDBXAsyncValue }>, flags?: number): Promise<MDBXAsyncPutBatchResultItem[]>;
   delBatch(keys: MDBXKey[]): Promise<MDBXAsyncDelBatchResultItem[]>;
 }
@@ -56,7 +78,7 @@ export declare class MDBX_Async_Txn {
 }
 
 export declare class MDBX_Async_Env {
-  constructor(workerCount?: number);
+  constructor(options?: MDBXAsyncEnvOptions | number);
   open(opts: MDBXEnvOpenOptions): Promise<void>;
   close(): Promise<void>;
   terminate(): Promise<void>;
@@ -0,0 +1,269 @@
+"use strict";
+// Пакет операций для txn.execute(): опкоды и байты ключей/значений пишутся
+// в переиспользуемый буфер, native выполняет весь пакет за один вызов и
+// пишет ответы в выходной буфер. Раскладка описана в src/batchmou.cpp.
+//
+// Кодирование повторяет нативные правила DBI: строки - utf8, Buffer как
+// есть, ordinal-ключи и значения - 8 байт little-endian (с учетом
+// keyMode.int64/float64). keyFlag.tuple и valueFlag.object не поддержаны.
+
+const OP_GET = 1;
+const OP_PUT = 2;
+const OP_DEL = 3;
+const OP_HAS = 4;
+
+const STATUS_OK = 0;
+
+// флаги DBI (src/typemou.hpp)
+const FLAG_STRING = 2;
+const FLAG_BIGINT = 8;
+const FLAG_OBJECT = 16;
+const FLAG_TUPLE = 32;
+const KEY_ORDINAL = 0x08;
+const KEY_SIGNED = 0x100000;
+const KEY_FLOAT = 0x200000;
+const VALUE_INTEGERDUP = 0x20;
+
+const SIGN_BIT = 1n << 63n;
+const MAX_U64 = (1n << 64n) - 1n;
+const MAX_DBIS = 256;
+
+const scratch = new DataView(new ArrayBuffer(8));
+
+function ordinalKey(dbi, key) {
+  const mode = dbi.keyMode;
+  if (mode & KEY_FLOAT) {
+    if (typeof key !== "number" || Number.isNaN(key)) {
+      throw new TypeError("MDBX_Batch: float64 key must be a Number, not NaN");
+    }
+    scratch.setFloat64(0, key === 0 ? 0 : key, true);
+    const bits = scratch.getBigUint64(0, true);
+    return (bits & SIGN_BIT) ? BigInt.asUintN(64, ~bits) : bits | SIGN_BIT;
+  }
+  const n = BigInt(key);
+  if (mode & KEY_SIGNED) {
+    if (n < -SIGN_BIT || n >= SIGN_BIT) {
+      throw new RangeError("MDBX_Batch: int64 key out of range");
+    }
+    return BigInt.asUintN(64, n) ^ SIGN_BIT;
+  }
+  return n;
+}
+
+// native кодеки tuple/object в пакете не вызываются, поэтому такие DBI
+// отклоняются для всех операций, а не только для put
+function checkDbi(dbi) {
+  if (dbi.keyFlag & FLAG_TUPLE) {
+    throw new TypeError("MDBX_Batch: keyFlag.tuple is not supported");
+  }
+  if (dbi.valueFlag & FLAG_OBJECT) {
+    throw new TypeError("MDBX_Batch: valueFlag.object is not supported");
+  }
+}
+
+class MDBX_Batch {
+  constructor({ inputSize = 64 * 1024, outputSize = 256 * 1024 } = {}) {
+    this._input = Buffer.allocUnsafe(inputSize);
+    this._output = Buffer.allocUnsafe(outputSize);
+    this._length = 0;
+    this._dbis = [];
+    this._index = new Map();
+    // смещение начала каждой операции - для продолжения после переполнения
+    this._offsets = [];
+    this._ops = [];
+  }
+
+  get length() {
+    return this._ops.length;
+  }
+
+  clear() {
+    this._length = 0;
+    this._dbis.length = 0;
+    this._index.clear();
+    this._offsets.length = 0;
+    this._ops.length = 0;
+    return this;
+  }
+
+  get(dbi, key) {
+    return this._record(() => this._push(OP_GET, dbi, key));
+  }
+
+  has(dbi, key) {
+    return this._record(() => this._push(OP_HAS, dbi, key));
+  }
+
+  del(dbi, key) {
+    return this._record(() => this._push(OP_DEL, dbi, key));
+  }
+
+  // flags - MDBX_Param.putFlag: noOverwrite/noDupData/current/append/appendDup
+  put(dbi, key, value, flags = 0) {
+    checkDbi(dbi);
+    const ordinal = (dbi.valueMode & VALUE_INTEGERDUP) !== 0;
+    if (!ordinal && !(value instanceof Uint8Array) && typeof value !== "string") {
+      throw new TypeError("MDBX_Batch: value must be a Buffer or String");
+    }
+    return this._record(() => {
+      this._push(OP_PUT, dbi, key);
+      this._u32(flags >>> 0);
+      if (ordinal) {
+        this._ordinal(BigInt(value));
+      } else if (typeof value === "string") {
+        this._string(value);
+      } else {
+        this._bytes(value);
+      }
+    });
+  }
+
+  // выполняет пакет в txn и очищает его; results[i] - ответ на операцию i:
+  // get - значение или undefined, has/del - найден ли ключ, put - записан ли
+  // (false при noOverwrite/noDupData и существующем ключе)
+  execute(txn) {
+    const results = new Array(this._ops.length);
+    let done = 0;
+    try {
+      while (done < this._ops.length) {
+        const begin = this._offsets[done];
+        const input = this._input.subarray(begin, this._length);
+        const count = txn.execute(this._dbis, input, input.length, this._output);
+        if (count === 0) {
+          // ответ одного get больше выходного буфера
+          this._output = Buffer.allocUnsafe(Math.max(this._output.length * 2, 64));
+          continue;
+        }
+        this._decode(results, done, count);
+        done += count;
+      }
+    } finally {
+      // после ошибки операции до нее уже выполнены в txn
+      this.clear();
+    }
+    return results;
+  }
+
+  _decode(results, first, count) {
+    const out = this._output;
+    let pos = 0;
+    for (let i = first; i < first + count; ++i) {
+      const [op, dbi] = this._ops[i];
+      const ok = out[pos++] === STATUS_OK;
+      if (op !== OP_GET) {
+        results[i] = ok;
+        continue;
+      }
+      if (!ok) {
+        results[i] = undefined;
+        continue;
+      }
+      const size = out.readUInt32LE(pos);
+      pos += 4;
+      const bytes = out.subarray(pos, pos + size);
+      pos += size;
+      if (dbi.valueMode & VALUE_INTEGERDUP) {
+        const n = bytes.readBigUInt64LE(0);
+        results[i] = (dbi.valueFlag & FLAG_BIGINT) ? n : Number(n);
+      } else if (dbi.valueFlag & FLAG_STRING) {
+        results[i] = bytes.toString("utf8");
+      } else {
+        results[i] = Buffer.from(bytes);
+      }
+    }
+  }
+
+  // неудачная операция не оставляет в буфере половину записи
+  _record(write) {
+    const length = this._length;
+    const ops = this._ops.length;
+    const dbis = this._dbis.length;
+    try {
+      write();
+    } catch (e) {
+      this._length = length;
+      this._ops.length = ops;
+      this._offsets.length = ops;
+      for (const dbi of this._dbis.splice(dbis)) {
+        this._index.delete(dbi);
+      }
+      throw e;
+    }
+    return this;
+  }
+
+  _push(op, dbi, key) {
+    checkDbi(dbi);
+    let index = this._index.get(dbi);
+    if (index === undefined) {
+      if (this._dbis.length === MAX_DBIS) {
+        throw new RangeError("MDBX_Batch: too many DBIs in one batch");
+      }
+      index = this._dbis.length;
+      this._dbis.push(dbi);
+      this._index.set(dbi, index);
+    }
+    this._offsets.push(this._length);
+    this._ops.push([op, dbi]);
+    this._reserve(2);
+    this._input[this._length++] = op;
+    this._input[this._length++] = index;
+
+    if (dbi.keyMode & KEY_ORDINAL) {
+      this._ordinal(ordinalKey(dbi, key));
+    } else if (key instanceof Uint8Array) {
+      this._bytes(key);
+    } else if (typeof key === "string") {
+      this._string(key);
+    } else {
+      throw new TypeError("MDBX_Batch: key must be a Buffer or String");
+    }
+  }
+
+  _reserve(size) {
+    const need = this._length + size;
+    if (need <= this._input.length) {
+      return;
+    }
+    let capacity = this._input.length * 2;
+    while (capacity < need) {
+      capacity *= 2;
+    }
+    const input = Buffer.allocUnsafe(capacity);
+    this._input.copy(input, 0, 0, this._length);
+    this._input = input;
+  }
+
+  _u32(v) {
+    this._reserve(4);
+    this._input.writeUInt32LE(v, this._length);
+    this._length += 4;
+  }
+
+  _ordinal(n) {
+    if (n < 0n || n > MAX_U64) {
+      throw new RangeError("MDBX_Batch: ordinal out of 64-bit range");
+    }
+    this._u32(8);
+    this._reserve(8);
+    this._input.writeBigUInt64LE(n, this._length);
+    this._length += 8;
+  }
+
+  _bytes(bytes) {
+    this._u32(bytes.byteLength);
+    this._reserve(bytes.byteLength);
+    this._input.set(bytes, this._length);
+    this._length += bytes.byteLength;
+  }
+
+  _string(s) {
+    const size = Buffer.byteLength(s, "utf8");
+    this._u32(size);
+    this._reserve(size);
+    this._input.write(s, this._length, "utf8");
+    this._length += size;
+  }
+}
+
+module.exports = { MDBX_Batch };
@@ -7,6 +7,7 @@ const { MDBX_Async_Env } = require("./mdbx_evn_async.js");
 
 export const MDBX_Env = native.MDBX_Env;
 export const MDBX_Param = native.MDBX_Param;
+export const MDBX_Batch = native.MDBX_Batch;
 export { MDBX_Async_Env };
 
 export default native;
@@ -1,61 +1,202 @@
 "use strict";
-const { Worker } = require("worker_threads");
+const { Worker, MessageChannel } = require("worker_threads");
+const { Ring, DEFAULT_RING_SIZE, decode, pack } = require("./ring.js");
+const { Packed_Values } = require("./packed.js");
 const workerFile = require.resolve("./mdbx_worker.js");
 let nextReqId = 1;
 let nextTxnId = 1;
 let nextDbiId = 1;
 
-class MDBX_Async_Env {
-  constructor() {
-    this.worker = null;
-    // Ожидающие запросы: id -> { resolve, reject }
-    this.pending = new Map();
-    this.envOpened = false;
+function parseOptions(options) {
+  // число в конструкторе исторически допускалось и игнорируется
+  if (options === undefined || options === null || typeof options === "number") {
+    return { transport: "message", ringSize: DEFAULT_RING_SIZE, readers: 0 };
+  }
+  if (typeof options !== "object") {
+    throw new TypeError("MDBX_Async_Env: options must be an object");
   }
+  const transport = options.transport ?? "message";
+  if (transport !== "message" && transport !== "ring") {
+    throw new TypeError("MDBX_Async_Env: transport must be 'message' or 'ring'");
+  }
+  const readers = options.readers ?? 0;
+  if (!Number.isInteger(readers) || readers < 0 || readers > 256) {
+    throw new RangeError("MDBX_Async_Env: readers must be an integer in [0, 256]");
+  }
+  return {
+    transport,
+    ringSize: options.ringSize ?? DEFAULT_RING_SIZE,
+    readers,
+  };
+}
+
+// Один воркер и его транспорт. Ответы всех воркеров разрешают
+// общую таблицу ожидающих запросов окружения по id.
+class Worker_Channel {
+  constructor(env, options) {
+    this._env = env;
+    // запросы в полете через этот воркер
+    this.inflight = 0;
+    // открытые транзакции, по ним выбирается наименее занятый читатель
+    this.txns = 0;
+    // transport: 'ring' - кольца запросов/ответов в SharedArrayBuffer
+    this.ring = null;
+
+    this.worker = (options.transport === "ring") ?
+      new Worker(workerFile, this._createRing(options.ringSize)) :
+      new Worker(workerFile);
 
-  _createWorker() {
-    const w = new Worker(workerFile);
-    
     // Обработка ответов
-    w.on("message", (m) => {
-      const p = this.pending.get(m.id);
-      if (!p) return; // неизвестный или уже очищенный
-      this.pending.delete(m.id);
-      if (m.ok) {
-        p.resolve(m.result);
-      } else {
-        p.reject(new Error(m.error));
-      }
-    });
-    
+    this.worker.on("message", (m) => this._settle(m));
+
     // Обработка ошибок воркера
-    w.on("error", (e) => {
-      for (const [id, p] of this.pending) {
-        p.reject(e);
-        this.pending.delete(id);
-      }
-    });
-    
+    this.worker.on("error", (e) => env._rejectAll(e));
+
     // При выходе воркера
-    w.on("exit", (code) => {
+    this.worker.on("exit", (code) => {
       if (code !== 0) {
-        const err = new Error(`worker exited with code ${code}`);
-        for (const [id, p] of this.pending) {
-          p.reject(err);
-          this.pending.delete(id);
-        }
+        env._rejectAll(new Error(`worker exited with code ${code}`));
       }
     });
-    
-    return w;
   }
 
-  _dispatch(cmd, params) {
+  _createRing(ringSize) {
+    const { port1, port2 } = new MessageChannel();
+    const requests = Ring.create(ringSize);
+    const responses = Ring.create(ringSize);
+    this.ring = {
+      requests,
+      responses,
+      port: port1,
+      // кадры, не поместившиеся в кольцо запросов, в порядке отправки
+      backlog: [],
+      pumping: false,
+    };
+    return {
+      workerData: {
+        transport: "ring",
+        requests: requests.sab,
+        responses: responses.sab,
+        port: port2,
+      },
+      transferList: [port2],
+    };
+  }
+
+  _settle(m) {
+    if (this.inflight > 0) this.inflight--;
+    this._env._settle(m);
+  }
+
+  send(message) {
+    this.inflight++;
+    if (!this.ring) {
+      this.worker.postMessage(message);
+      return;
+    }
+    const ring = this.ring;
+    const frame = pack(ring.requests, message, ring.port);
+    // пока есть хвост, новые кадры встают за ним
+    if (ring.backlog.length > 0 || !ring.requests.tryWrite(frame)) {
+      // frame ссылается на общий буфер кодека
+      ring.backlog.push(Buffer.from(frame));
+    }
+    this._pump();
+  }
+
+  _flushBacklog() {
+    const { backlog, requests } = this.ring;
+    let i = 0;
+    while (i < backlog.length && requests.tryWrite(backlog[i])) {
+      i++;
+    }
+    if (i > 0) {
+      backlog.splice(0, i);
+    }
+  }
+
+  _drainResponses() {
+    const { responses, port } = this.ring;
+    let frame;
+    while ((frame = responses.read()) !== null) {
+      this._settle(decode(frame, port));
+    }
+  }
+
+  // читает ответы, пока есть запросы в полете; без них ничего не ждет,
+  // чтобы не удерживать event loop
+  _pump() {
+    const ring = this.ring;
+    if (ring.pumping) return;
+    ring.pumping = true;
+    const loop = async () => {
+      try {
+        while (this.ring === ring && this.inflight > 0) {
+          this._drainResponses();
+          this._flushBacklog();
+          if (this.inflight === 0) break;
+          await ring.responses.waitReadable(1000);
+        }
+      } finally {
+        // сбрасывается синхронно с последней проверкой inflight,
+        // иначе запрос, отправленный в этот момент, остался бы без ответа
+        ring.pumping = false;
+      }
+    };
+    loop().catch((e) => this._env._rejectAll(e));
+  }
+
+  async terminate() {
+    if (this.ring) {
+      this.ring.requests.close();
+      this.ring.port.close();
+      this.ring = null;
+    }
+    this.inflight = 0;
+    await this.worker.terminate();
+  }
+}
+
+class MDBX_Async_Env {
+  constructor(options) {
+    // пишущий воркер; без читателей он же обслуживает чтение
+    this.worker = null;
+    // readers > 0 - отдельные воркеры для читающих транзакций
+    this.readers = [];
+    // Ожидающие запросы: id -> { resolve, reject }
+    this.pending = new Map();
+    this.envOpened = false;
+    this.options = parseOptions(options);
+  }
+
+  _settle(m) {
+    const p = this.pending.get(m.id);
+    if (!p) return; // неизвестный или уже очищенный
+    this.pending.delete(m.id);
+    if (m.ok) {
+      p.resolve(m.result);
+    } else {
+      p.reject(new Error(m.error));
+    }
+  }
+
+  _rejectAll(e) {
+    for (const [id, p] of this.pending) {
+      p.reject(e);
+      this.pending.delete(id);
+    }
+  }
+
+  _channels() {
+    return this.worker ? [this.worker, ...this.readers] : [];
+  }
+
+  _dispatch(channel, cmd, params) {
     const id = nextReqId++;
     return new Promise((resolve, reject) => {
       this.pending.set(id, { resolve, reject });
       try {
-        this.worker.postMessage({ id, cmd, params });
+        channel.send({ id, cmd, params });
       } catch (e) {
         // Если отправка упала синхронно, чистим
         if (this.pending.get(id)) this.pending.delete(id);
@@ -64,18 +205,43 @@ class MDBX_Async_Env {
     });
   }
 
+  // читатель с наименьшим числом открытых транзакций
+  _pickReader() {
+    if (this.readers.length === 0) {
+      return this.worker;
+    }
+    let best = this.readers[0];
+    for (const r of this.readers) {
+      if (r.txns < best.txns) best = r;
+    }
+    return best;
+  }
+
   async open(opts) {
     if (this.envOpened) throw new Error("env already open");
     if (!this.worker) {
-      this.worker = this._createWorker();
+      this.worker = new Worker_Channel(this, this.options);
+      for (let i = 0; i < this.options.readers; i++) {
+        this.readers.push(new Worker_Channel(this, this.options));
+      }
+    }
+    // все воркеры процесса разделяют одно окружение по пути
+    await this._dispatch(this.worker, "env_open", opts);
+    try {
+      await Promise.all(this.readers.map(
+        (r) => this._dispatch(r, "env_open", opts)));
+    } catch (e) {
+      await Promise.allSettled(this._channels().map(
+        (c) => this._dispatch(c, "env_close")));
+      throw e;
     }
-    await this._dispatch("env_open", opts);
     this.envOpened = true;
   }
 
   async close() {
     if (!this.envOpened) return;
-    await this._dispatch("env_close");
+    await Promise.all(this._channels().map(
+      (c) => this._dispatch(c, "env_close")));
     this.envOpened = false;
   }
 
@@ -84,39 +250,48 @@ class MDBX_Async_Env {
     if (this.envOpened) {
       await this.close();
     }
-    
+
     // Отменяем все ожидающие запросы
     const cancelError = new Error("Environment terminated");
     for (const [id, p] of this.pending) {
       p.reject(cancelError);
     }
     this.pending.clear();
-    
-    // Завершаем worker
-    if (this.worker) {
-      await this.worker.terminate();
-      this.worker = null;
-    }
+
+    // Завершаем воркеры
+    const channels = this._channels();
+    this.worker = null;
+    this.readers = [];
+    await Promise.all(channels.map((c) => c.terminate()));
   }
 
   async startWrite() {
     if (!this.worker) throw new Error("Environment not opened");
     const txnId = nextTxnId++;
-    await this._dispatch("txn_begin", { txnId, mode: "write" });
-    return new Txn_Proxy(this, txnId, true);
+    await this._dispatch(this.worker, "txn_begin", { txnId, mode: "write" });
+    return new Txn_Proxy(this, this.worker, txnId, true);
   }
 
   async startRead() {
     if (!this.worker) throw new Error("Environment not opened");
+    // транзакция закреплена за воркером, в котором создана
+    const channel = this._pickReader();
     const txnId = nextTxnId++;
-    await this._dispatch("txn_begin", { txnId, mode: "read" });
-    return new Txn_Proxy(this, txnId, false);
+    channel.txns++;
+    try {
+      await this._dispatch(channel, "txn_begin", { txnId, mode: "read" });
+    } catch (e) {
+      channel.txns--;
+      throw e;
+    }
+    return new Txn_Proxy(this, channel, txnId, false);
   }
 }
 
 class Txn_Proxy {
-  constructor(env, txnId, write) {
+  constructor(env, channel, txnId, write) {
     this._env = env;
+    this._channel = channel;
     this._txnId = txnId;
     this._write = write;
     this._closed = false;
@@ -124,7 +299,15 @@ class Txn_Proxy {
 
   _call(cmd, params) {
     if (this._closed) return Promise.reject(new Error("txn closed"));
-    return this._env._dispatch(cmd, { txnId: this._txnId, ...params });
+    return this._env._dispatch(this._channel, cmd,
+      { txnId: this._txnId, ...params });
+  }
+
+  _finish() {
+    this._closed = true;
+    if (!this._write && this._channel.txns > 0) {
+      this._channel.txns--;
+    }
   }
 
   async openMap(opts = {}) {
@@ -146,13 +329,32 @@ class Txn_Proxy {
   async commit() {
     if (this._closed) return;
     await this._call("txn_commit");
-    this._closed = true;
+    this._finish();
   }
 
   async abort() {
     if (this._closed) return;
     await this._call("txn_abort");
-    this._closed = true;
+    this._finish();
+  }
+}
+
+// Результат getBatch({ lazy: true }): значение декодируется при первом
+// обращении
+class Batch_Item {
+  constructor(key, values, index) {
+    this.key = key;
+    this.found = values.has(index);
+    this._values = values;
+    this._index = index;
+  }
+
+  get value() {
+    return this.found ? this._values.at(this._index) : null;
+  }
+
+  toJSON() {
+    return { key: this.key, value: this.value, found: this.found };
   }
 }
 
@@ -184,16 +386,30 @@ class Dbi_Proxy {
   }
 
   forEach(cb) {
-    // Потоково: worker возвращает батчи
-    return this._call("dbi_iter_all", {}).then(arr => {
-      arr.forEach((kv, i) => cb(kv.key, kv.value, i));
+    // worker возвращает ключи и значения упакованными,
+    // элементы разворачиваются по одному перед вызовом cb
+    return this._call("dbi_iter_all", {}).then(({ keys, values }) => {
+      const k = new Packed_Values(keys);
+      const v = new Packed_Values(values);
+      for (let i = 0; i < k.length; i++) {
+        cb(k.at(i), v.at(i), i);
+      }
     });
   }
 
   // Групповые операции
-  getBatch(keys) {
+  getBatch(keys, { lazy = false } = {}) {
     // Читаем множество ключей одной командой
-    return this._call("dbi_get_batch", { keys });
+    return this._call("dbi_get_batch", { keys }).then((packed) => {
+      const values = new Packed_Values(packed);
+      if (lazy) {
+        return keys.map((key, i) => new Batch_Item(key, values, i));
+      }
+      return keys.map((key, i) => {
+        const found = values.has(i);
+        return { key, value: found ? values.at(i) : null, found };
+      });
+    });
   }
 
   putBatch(items, flags = 0) {
@@ -1,6 +1,8 @@
 "use strict";
-const { parentPort } = require("worker_threads");
+const { parentPort, workerData } = require("worker_threads");
 const MDBX = require("./nativemou.js");
+const { Ring, decode, pack } = require("./ring.js");
+const { packValues } = require("./packed.js");
 const { MDBX_Env } = MDBX;
 
 // Хранилища
@@ -8,8 +10,11 @@ let env = null;
 const txns = new Map();   // txnId -> { txn, write }
 const dbis = new Map();   // dbiId -> { txnId, dbi }
 
-function ok(id, result) { parentPort.postMessage({ id, ok: true, result }); }
-function fail(id, error) { parentPort.postMessage({ id, ok: false, error }); }
+// Ответ уходит тем же транспортом, которым пришел запрос
+let reply = (message, transfer) => parentPort.postMessage(message, transfer);
+
+function ok(id, result, transfer) { reply({ id, ok: true, result }, transfer); }
+function fail(id, error) { reply({ id, ok: false, error }); }
 
 async function handler(msg) {
   const { id, cmd, params } = msg;
@@ -127,12 +132,17 @@ async function handler(msg) {
         if (!t) throw new Error("no txn");
         const d = dbis.get(dbiId);
         if (!d || d.txnId !== txnId) throw new Error("no dbi");
-        const out = [];
+        const keys = [];
+        const values = [];
         d.dbi.forEach(t.txn, (k, v) => {
-          out.push({ key: k, value: v });
-          return true;
+          keys.push(k);
+          values.push(v);
         });
-        return ok(id, out);
+        // ключи и значения - два упакованных списка без копий на пути
+        const packedKeys = packValues(keys);
+        const packedValues = packValues(values);
+        return ok(id, { keys: packedKeys, values: packedValues },
+          [packedKeys.buffer, packedValues.buffer]);
       }
 
       case "dbi_get_batch": {
@@ -143,21 +153,17 @@ async function handler(msg) {
         const d = dbis.get(dbiId);
         if (!d || d.txnId !== txnId) throw new Error("no dbi");
         
-        const results = [];
+        // ключи у вызывающего уже есть, обратно идут только значения
+        const values = [];
         for (const key of keys) {
           try {
-            const val = d.dbi.get(t.txn, key);
-            if (val !== undefined && val !== null) {
-              const result = (val && Buffer.isBuffer(val)) ? val.toString() : val;
-              results.push({ key, value: result, found: true });
-            } else {
-              results.push({ key, value: null, found: false });
-            }
+            values.push(d.dbi.get(t.txn, key));
           } catch (e) {
-            results.push({ key, value: null, found: false });
+            values.push(undefined);
           }
         }
-        return ok(id, results);
+        const packed = packValues(values, { utf8: true });
+        return ok(id, packed, [packed.buffer]);
       }
 
       case "dbi_put_batch": {
@@ -208,4 +214,35 @@ async function handler(msg) {
   }
 }
 
+// transport: 'ring' - запросы и ответы через кольца в SharedArrayBuffer,
+// команды выполняются строго по очереди, как и при postMessage
+async function serveRing({ requests, responses, port }) {
+  const rx = new Ring(requests);
+  const tx = new Ring(responses);
+
+  reply = (message, transfer) => {
+    const frame = pack(tx, message, port, transfer);
+    // главный поток читает ответы асинхронно, воркеру можно блокироваться
+    while (!tx.tryWrite(frame)) {
+      tx.waitWritable(100);
+    }
+  };
+
+  while (!rx.closed) {
+    const frame = rx.read();
+    if (frame === null) {
+      await rx.waitReadable(1000);
+      continue;
+    }
+    await handler(decode(frame, port));
+  }
+}
+
 parentPort.on("message", handler);
+
+if (workerData && workerData.transport === "ring") {
+  serveRing(workerData).catch((e) => {
+    // транспорт сломан - ожидающие запросы отклонит событие error
+    process.nextTick(() => { throw e; });
+  });
+}
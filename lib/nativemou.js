@@ -1,5 +1,168 @@
 const nativePath = '../build/Release/mdbxmou';
 /** @type {import("./types").MDBX_Native} */
 const nativeModule = require(nativePath);
+
+// Хвост журнала изменений поверх env.readChanges(): отдает операции
+// транзакций новее sinceTxnid и ждет следующих фиксаций через env.watch()
+nativeModule.MDBX_Env.prototype.changes = async function* changes(options = {}) {
+    const { limit = 1024, intervalMs, signal } = options;
+    let sinceTxnid = options.sinceTxnid ?? 0;
+    let committed = false;
+    let wake = null;
+    const onCommit = () => {
+        committed = true;
+        wake?.();
+    };
+    const onAbort = () => wake?.();
+    const stopWatch = this.watch(onCommit, intervalMs === undefined ? undefined : { intervalMs });
+    signal?.addEventListener('abort', onAbort, { once: true });
+    try {
+        while (!signal?.aborted) {
+            committed = false;
+            const { changes } = await this.readChanges({ sinceTxnid, limit });
+            for (const change of changes) {
+                yield change;
+            }
+            if (changes.length > 0) {
+                sinceTxnid = changes[changes.length - 1].txnId;
+                continue;
+            }
+            // фиксация между readChanges() и ожиданием не теряется,
+            // как и отмена во время readChanges()
+            if (!committed && !signal?.aborted) {
+                await new Promise((resolve) => {
+                    wake = resolve;
+                });
+                wake = null;
+            }
+        }
+    } finally {
+        signal?.removeEventListener('abort', onAbort);
+        stopWatch();
+    }
+};
+
+// Автопарковка: читающая транзакция, не использованная за autoParkMs,
+// паркуется с autounpark (mdbx_txn_park) и перестает удерживать снимок;
+// следующее обращение распаркует ее само
+const { startRead } = nativeModule.MDBX_Env.prototype;
+nativeModule.MDBX_Env.prototype.startRead = function startReadParkable(options) {
+    const autoParkMs = options?.autoParkMs;
+    if (autoParkMs !== undefined &&
+        (typeof autoParkMs !== 'number' || !(autoParkMs > 0) || !Number.isFinite(autoParkMs))) {
+        throw new RangeError('startRead: autoParkMs must be a positive number');
+    }
+    const txn = startRead.call(this);
+    if (autoParkMs !== undefined) {
+        // таймер не держит транзакцию: брошенную без abort() соберет GC,
+        // и Finalize освободит слот читателя
+        const ref = new WeakRef(txn);
+        const timer = setInterval(() => {
+            const held = ref.deref();
+            if (!held || !held._parkIfIdle()) {
+                clearInterval(timer);
+            }
+        }, autoParkMs);
+        timer.unref();
+    }
+    return txn;
+};
+
+// Общий снимок для чтений, допускающих отставание до maxAgeMs: одна
+// читающая транзакция на всех пользователей со счетчиком ссылок вместо
+// startRead()/abort() на каждый запрос. Пока снимком пользуются, таймер
+// заменяет его свежим каждые maxAgeMs; замененный прерывается после
+// последнего release(), а простоявший период без обращений - сразу, чтобы
+// не держать MVCC. Занятый старый снимок и новый живут одновременно, что
+// в одном потоке возможно только с nostickythreads
+const kSnapshot = Symbol('mdbxmou.snapshot');
+
+function retireSnapshot(shared) {
+    shared.stale = true;
+    clearTimeout(shared.timer);
+    if (shared.refs === 0 && shared.txn.isActive()) {
+        shared.txn.abort();
+    }
+}
+
+function renewSnapshot(env, maxAgeMs) {
+    const txn = env.startRead();
+    const previous = env[kSnapshot];
+    if (previous) {
+        retireSnapshot(previous);
+    }
+    const shared = {
+        txn, startedAt: performance.now(), refs: 0, used: false, stale: false, timer: null,
+    };
+    shared.timer = setTimeout(() => {
+        if (env[kSnapshot] !== shared) {
+            return;
+        }
+        // фоновое обновление только для используемого снимка
+        if (maxAgeMs > 0 && shared.used) {
+            try {
+                renewSnapshot(env, maxAgeMs);
+                return;
+            } catch {
+                // окружение закрывается: снимок просто прерывается
+            }
+        }
+        retireSnapshot(shared);
+        env[kSnapshot] = undefined;
+    }, maxAgeMs);
+    shared.timer.unref();
+    env[kSnapshot] = shared;
+    return shared;
+}
+
+nativeModule.MDBX_Env.prototype.snapshot = function snapshot(options = {}) {
+    const { maxAgeMs = 0 } = options;
+    if (typeof maxAgeMs !== 'number' || !(maxAgeMs >= 0) || !Number.isFinite(maxAgeMs)) {
+        throw new RangeError('snapshot: maxAgeMs must be a non-negative number');
+    }
+    // без nostickythreads открытый снимок не дал бы начать в этом потоке
+    // ни замену, ни startRead()/startWrite()
+    if ((this._envFlags() & nativeModule.MDBX_Param.envFlag.nostickythreads) === 0) {
+        throw new Error('snapshot: requires envFlag.nostickythreads');
+    }
+    let shared = this[kSnapshot];
+    if (!shared || shared.stale || performance.now() - shared.startedAt > maxAgeMs) {
+        shared = renewSnapshot(this, maxAgeMs);
+    }
+    const current = shared;
+    ++current.refs;
+    current.used = true;
+    let released = false;
+    return {
+        txn: current.txn,
+        release() {
+            if (released) {
+                return;
+            }
+            released = true;
+            if (--current.refs === 0 &&
+                (current.stale || performance.now() - current.startedAt > maxAgeMs)) {
+                retireSnapshot(current);
+            }
+        },
+    };
+};
+
+// закрытие не должно упираться в простаивающий общий снимок
+for (const name of ['close', 'closeSync']) {
+    const close = nativeModule.MDBX_Env.prototype[name];
+    nativeModule.MDBX_Env.prototype[name] = function closeWithSnapshot(...args) {
+        const shared = this[kSnapshot];
+        if (shared && shared.refs === 0) {
+            retireSnapshot(shared);
+            this[kSnapshot] = undefined;
+        }
+        return close.apply(this, args);
+    };
+}
+
+// пакет get/put/del/has за один вызов txn.execute()
+nativeModule.MDBX_Batch = require('./batch.js').MDBX_Batch;
+
 // Экспортируем объединенный модуль
 module.exports = nativeModule;
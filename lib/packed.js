@@ -0,0 +1,112 @@
+"use strict";
+// Упаковка списка значений в один ArrayBuffer для ответа воркера.
+// Буфер уходит в transfer list, на главном потоке значения
+// разворачиваются по требованию, Buffer - представление без копирования.
+//
+// Раскладка: u32 count | kinds[count] (выравнено на 4) |
+//            u32 offsets[count + 1] | данные
+// Значения, которые не являются байтами или строкой (number, bigint),
+// передаются в extra по индексу элемента.
+
+const KIND_MISSING = 0;
+const KIND_BYTES = 1;
+const KIND_UTF8 = 2;
+const KIND_OTHER = 3;
+
+function align4(n) {
+  return (n + 3) & ~3;
+}
+
+// utf8: true - байтовые значения разворачиваются строками
+function packValues(values, { utf8 = false } = {}) {
+  const count = values.length;
+  const kindsSize = align4(count);
+  const tableSize = 4 + kindsSize + 4 * (count + 1);
+
+  let dataSize = 0;
+  for (const v of values) {
+    if (typeof v === "string") {
+      dataSize += Buffer.byteLength(v);
+    } else if (ArrayBuffer.isView(v)) {
+      dataSize += v.byteLength;
+    }
+  }
+
+  const buffer = new ArrayBuffer(tableSize + dataSize);
+  const view = new DataView(buffer);
+  const kinds = new Uint8Array(buffer, 4, count);
+  const offsets = new Uint32Array(buffer, 4 + kindsSize, count + 1);
+  const data = Buffer.from(buffer, tableSize, dataSize);
+  const extra = {};
+
+  view.setUint32(0, count, true);
+  let pos = 0;
+  for (let i = 0; i < count; i++) {
+    const v = values[i];
+    offsets[i] = pos;
+    if (v === undefined || v === null) {
+      kinds[i] = KIND_MISSING;
+    } else if (typeof v === "string") {
+      kinds[i] = KIND_UTF8;
+      pos += data.write(v, pos, "utf8");
+    } else if (ArrayBuffer.isView(v)) {
+      kinds[i] = utf8 ? KIND_UTF8 : KIND_BYTES;
+      data.set(new Uint8Array(v.buffer, v.byteOffset, v.byteLength), pos);
+      pos += v.byteLength;
+    } else {
+      kinds[i] = KIND_OTHER;
+      extra[i] = v;
+    }
+  }
+  offsets[count] = pos;
+
+  return { buffer, extra };
+}
+
+class Packed_Values {
+  // buffer - ArrayBuffer после postMessage или Uint8Array после кольца
+  constructor({ buffer, extra }) {
+    const bytes = ArrayBuffer.isView(buffer) ?
+      buffer : new Uint8Array(buffer);
+    const base = bytes.byteOffset;
+    const ab = bytes.buffer;
+    const count = new DataView(ab, base, 4).getUint32(0, true);
+    const kindsSize = align4(count);
+
+    this._ab = ab;
+    this._extra = extra;
+    this.length = count;
+    this._kinds = new Uint8Array(ab, base + 4, count);
+    // смещение base у Uint8Array после кольца может быть не кратно 4
+    this._offsets = new DataView(ab, base + 4 + kindsSize, 4 * (count + 1));
+    this._data = base + 4 + kindsSize + 4 * (count + 1);
+    // развернутые значения: повторный at(i) не декодирует заново
+    this._cache = new Array(count);
+  }
+
+  has(i) {
+    return this._kinds[i] !== KIND_MISSING;
+  }
+
+  // undefined для отсутствующего значения
+  at(i) {
+    const kind = this._kinds[i];
+    if (kind === KIND_MISSING) {
+      return undefined;
+    }
+    if (kind === KIND_OTHER) {
+      return this._extra[i];
+    }
+    let value = this._cache[i];
+    if (value === undefined) {
+      const begin = this._offsets.getUint32(4 * i, true);
+      const end = this._offsets.getUint32(4 * (i + 1), true);
+      const bytes = Buffer.from(this._ab, this._data + begin, end - begin);
+      value = (kind === KIND_UTF8) ? bytes.toString("utf8") : bytes;
+      this._cache[i] = value;
+    }
+    return value;
+  }
+}
+
+module.exports = { packValues, Packed_Values };
@@ -0,0 +1,414 @@
+"use strict";
+// Однонаправленное кольцо (один писатель, один читатель) в SharedArrayBuffer
+// и компактный двоичный кодек сообщений для прокси MDBX_Async_Env.
+// Синхронизация только через Atomics: писатель двигает tail, читатель head,
+// ожидание - Atomics.wait/waitAsync на соответствующем счетчике.
+const { receiveMessageOnPort } = require("worker_threads");
+
+const HEAD = 0;
+const TAIL = 1;
+const CLOSED = 2;
+const HEADER_BYTES = 16;
+const FRAME_HEADER = 4;
+
+// первый байт кадра: сообщение в кольце или следующее сообщение в порту
+const FRAME_INLINE = 0;
+const FRAME_OVERFLOW = 1;
+
+const DEFAULT_RING_SIZE = 1 << 20;
+
+function align4(n) {
+  return (n + 3) & ~3;
+}
+
+class Ring {
+  constructor(sab) {
+    this.sab = sab;
+    this.state = new Int32Array(sab, 0, HEADER_BYTES >> 2);
+    this.data = new Uint8Array(sab, HEADER_BYTES);
+    this.view = new DataView(sab, HEADER_BYTES);
+    this.capacity = this.data.length;
+    this.mask = this.capacity - 1;
+  }
+
+  static create(size = DEFAULT_RING_SIZE) {
+    if (!Number.isInteger(size) || size < 4096 || size > (1 << 30) ||
+        (size & (size - 1)) !== 0) {
+      throw new RangeError("ringSize must be a power of two in [4096, 2^30]");
+    }
+    return new Ring(new SharedArrayBuffer(HEADER_BYTES + size));
+  }
+
+  // наибольшая полезная нагрузка, помещающаяся в кольцо
+  get maxPayload() {
+    return this.capacity - FRAME_HEADER;
+  }
+
+  get closed() {
+    return Atomics.load(this.state, CLOSED) !== 0;
+  }
+
+  close() {
+    Atomics.store(this.state, CLOSED, 1);
+    Atomics.notify(this.state, TAIL);
+    Atomics.notify(this.state, HEAD);
+  }
+
+  // false, если места нет; позиции кадров выровнены на 4, поэтому
+  // заголовок длины никогда не разрывается границей кольца
+  tryWrite(payload) {
+    const need = FRAME_HEADER + align4(payload.length);
+    if (need > this.capacity) {
+      throw new RangeError("frame exceeds ring capacity");
+    }
+    const head = Atomics.load(this.state, HEAD);
+    const tail = this.state[TAIL];
+    if (this.capacity - ((tail - head) >>> 0) < need) {
+      return false;
+    }
+
+    const pos = tail & this.mask;
+    this.view.setUint32(pos, payload.length, true);
+    const start = (pos + FRAME_HEADER) & this.mask;
+    const first = Math.min(payload.length, this.capacity - start);
+    this.data.set(payload.subarray(0, first), start);
+    if (first < payload.length) {
+      this.data.set(payload.subarray(first), 0);
+    }
+
+    Atomics.store(this.state, TAIL, (tail + need) | 0);
+    Atomics.notify(this.state, TAIL);
+    return true;
+  }
+
+  // копия следующего кадра или null
+  read() {
+    const tail = Atomics.load(this.state, TAIL);
+    const head = this.state[HEAD];
+    if (tail === head) {
+      return null;
+    }
+
+    const pos = head & this.mask;
+    const length = this.view.getUint32(pos, true);
+    const out = Buffer.allocUnsafe(length);
+    const start = (pos + FRAME_HEADER) & this.mask;
+    const first = Math.min(length, this.capacity - start);
+    out.set(this.data.subarray(start, start + first), 0);
+    if (first < length) {
+      out.set(this.data.subarray(0, length - first), first);
+    }
+
+    Atomics.store(this.state, HEAD, (head + FRAME_HEADER + align4(length)) | 0);
+    Atomics.notify(this.state, HEAD);
+    return out;
+  }
+
+  // ожидание нового кадра без блокировки event loop
+  async waitReadable(timeoutMs) {
+    const tail = Atomics.load(this.state, TAIL);
+    if (tail !== this.state[HEAD] || this.closed) {
+      return;
+    }
+    const r = Atomics.waitAsync(this.state, TAIL, tail, timeoutMs);
+    if (r.async) {
+      await r.value;
+    }
+  }
+
+  // блокирующее ожидание места, только для потока воркера
+  waitWritable(timeoutMs) {
+    const head = Atomics.load(this.state, HEAD);
+    Atomics.wait(this.state, HEAD, head, timeoutMs);
+  }
+}
+
+// Теги кодека. Покрывает то, что ходит между прокси и воркером:
+// примитивы, bigint, Buffer/Uint8Array, массивы и простые объекты.
+const T_UNDEFINED = 0;
+const T_NULL = 1;
+const T_FALSE = 2;
+const T_TRUE = 3;
+const T_INT32 = 4;
+const T_FLOAT64 = 5;
+const T_STRING = 6;
+const T_BYTES = 7;
+const T_BIGINT = 8;
+const T_ARRAY = 9;
+const T_OBJECT = 10;
+
+const SHORT_STRING = 32;
+
+class Writer {
+  constructor(size = 256) {
+    this.buf = Buffer.allocUnsafe(size);
+    this.pos = 0;
+  }
+
+  reserve(n) {
+    if (this.pos + n <= this.buf.length) {
+      return;
+    }
+    let size = this.buf.length * 2;
+    while (size < this.pos + n) {
+      size *= 2;
+    }
+    const next = Buffer.allocUnsafe(size);
+    this.buf.copy(next, 0, 0, this.pos);
+    this.buf = next;
+  }
+
+  u8(v) {
+    this.reserve(1);
+    this.buf[this.pos++] = v;
+  }
+
+  u32(v) {
+    this.reserve(4);
+    this.buf.writeUInt32LE(v, this.pos);
+    this.pos += 4;
+  }
+
+  string(s) {
+    // короткие ASCII-строки (ключи, имена команд) пишутся без вызова в C++
+    const n = s.length;
+    if (n <= SHORT_STRING) {
+      this.reserve(4 + n);
+      const buf = this.buf;
+      const start = this.pos + 4;
+      let i = 0;
+      for (; i < n; i++) {
+        const c = s.charCodeAt(i);
+        if (c >= 0x80) break;
+        buf[start + i] = c;
+      }
+      if (i === n) {
+        buf.writeUInt32LE(n, this.pos);
+        this.pos = start + n;
+        return;
+      }
+    }
+    const length = Buffer.byteLength(s);
+    this.u32(length);
+    this.reserve(length);
+    this.buf.write(s, this.pos, length, "utf8");
+    this.pos += length;
+  }
+
+  value(v) {
+    switch (typeof v) {
+      case "undefined":
+        return this.u8(T_UNDEFINED);
+      case "boolean":
+        return this.u8(v ? T_TRUE : T_FALSE);
+      case "number":
+        if (Number.isInteger(v) && v >= -0x80000000 && v <= 0x7fffffff &&
+            !Object.is(v, -0)) {
+          this.u8(T_INT32);
+          this.reserve(4);
+          this.buf.writeInt32LE(v, this.pos);
+          this.pos += 4;
+        } else {
+          this.u8(T_FLOAT64);
+          this.reserve(8);
+          this.buf.writeDoubleLE(v, this.pos);
+          this.pos += 8;
+        }
+        return;
+      case "string":
+        this.u8(T_STRING);
+        return this.string(v);
+      case "bigint": {
+        // знак отдельно, модуль little-endian
+        this.u8(T_BIGINT);
+        const negative = v < 0n;
+        let abs = negative ? -v : v;
+        const bytes = [];
+        while (abs > 0n) {
+          bytes.push(Number(abs & 0xffn));
+          abs >>= 8n;
+        }
+        this.u8(negative ? 1 : 0);
+        this.u32(bytes.length);
+        this.reserve(bytes.length);
+        for (const b of bytes) {
+          this.buf[this.pos++] = b;
+        }
+        return;
+      }
+      case "object":
+        break;
+      default:
+        throw new TypeError(`ring codec: unsupported type ${typeof v}`);
+    }
+
+    if (v === null) {
+      return this.u8(T_NULL);
+    }
+    if (ArrayBuffer.isView(v)) {
+      const bytes = new Uint8Array(v.buffer, v.byteOffset, v.byteLength);
+      this.u8(T_BYTES);
+      this.u32(bytes.length);
+      this.reserve(bytes.length);
+      this.buf.set(bytes, this.pos);
+      this.pos += bytes.length;
+      return;
+    }
+    if (v instanceof ArrayBuffer) {
+      return this.value(new Uint8Array(v));
+    }
+    if (Array.isArray(v)) {
+      this.u8(T_ARRAY);
+      this.u32(v.length);
+      for (const item of v) {
+        this.value(item);
+      }
+      return;
+    }
+
+    const keys = Object.keys(v);
+    this.u8(T_OBJECT);
+    this.u32(keys.length);
+    for (const key of keys) {
+      this.string(key);
+      this.value(v[key]);
+    }
+  }
+}
+
+class Reader {
+  constructor(buf, pos = 0) {
+    this.buf = buf;
+    this.pos = pos;
+  }
+
+  u32() {
+    const v = this.buf.readUInt32LE(this.pos);
+    this.pos += 4;
+    return v;
+  }
+
+  string() {
+    const length = this.u32();
+    const buf = this.buf;
+    const start = this.pos;
+    const end = start + length;
+    this.pos = end;
+    if (length <= SHORT_STRING) {
+      let s = "";
+      let i = start;
+      for (; i < end; i++) {
+        const c = buf[i];
+        if (c >= 0x80) break;
+        s += String.fromCharCode(c);
+      }
+      if (i === end) {
+        return s;
+      }
+    }
+    return buf.toString("utf8", start, end);
+  }
+
+  value() {
+    const tag = this.buf[this.pos++];
+    switch (tag) {
+      case T_UNDEFINED: return undefined;
+      case T_NULL: return null;
+      case T_FALSE: return false;
+      case T_TRUE: return true;
+      case T_INT32: {
+        const v = this.buf.readInt32LE(this.pos);
+        this.pos += 4;
+        return v;
+      }
+      case T_FLOAT64: {
+        const v = this.buf.readDoubleLE(this.pos);
+        this.pos += 8;
+        return v;
+      }
+      case T_STRING:
+        return this.string();
+      case T_BYTES: {
+        const length = this.u32();
+        // кадр уже скопирован из кольца, копировать еще раз не нужно
+        const v = this.buf.subarray(this.pos, this.pos + length);
+        this.pos += length;
+        return v;
+      }
+      case T_BIGINT: {
+        const negative = this.buf[this.pos++] === 1;
+        const length = this.u32();
+        let v = 0n;
+        for (let i = length - 1; i >= 0; i--) {
+          v = (v << 8n) | BigInt(this.buf[this.pos + i]);
+        }
+        this.pos += length;
+        return negative ? -v : v;
+      }
+      case T_ARRAY: {
+        const length = this.u32();
+        const out = new Array(length);
+        for (let i = 0; i < length; i++) {
+          out[i] = this.value();
+        }
+        return out;
+      }
+      case T_OBJECT: {
+        const length = this.u32();
+        const out = {};
+        for (let i = 0; i < length; i++) {
+          const key = this.string();
+          out[key] = this.value();
+        }
+        return out;
+      }
+      default:
+        throw new TypeError(`ring codec: unknown tag ${tag}`);
+    }
+  }
+}
+
+// буфер кодирования переиспользуется: кадр копируется в кольцо сразу,
+// а отложенные кадры копирует pack()
+const writer = new Writer(64 * 1024);
+
+function encode(value) {
+  writer.pos = 0;
+  writer.u8(FRAME_INLINE);
+  writer.value(value);
+  return writer.buf.subarray(0, writer.pos);
+}
+
+function decode(frame, port) {
+  if (frame[0] === FRAME_OVERFLOW) {
+    // сообщение больше кольца: отправлено в порт до записи кадра
+    const received = receiveMessageOnPort(port);
+    if (!received) {
+      throw new Error("ring: overflow message is missing");
+    }
+    return received.message;
+  }
+  return new Reader(frame, 1).value();
+}
+
+const OVERFLOW_FRAME = Buffer.from([FRAME_OVERFLOW]);
+
+// кадр для записи: сообщения больше кольца идут через порт,
+// в кольце остается метка, поэтому порядок сохраняется;
+// результат действителен до следующего вызова encode()/pack()
+function pack(ring, message, port, transfer) {
+  const frame = encode(message);
+  if (frame.length > ring.maxPayload) {
+    port.postMessage(message, transfer);
+    return OVERFLOW_FRAME;
+  }
+  return frame;
+}
+
+module.exports = {
+  Ring,
+  DEFAULT_RING_SIZE,
+  encode,
+  decode,
+  pack,
+};
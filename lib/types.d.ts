@@ -1,7 +1,13 @@
 /// <reference types="node" />
 
-export type MDBXKey = Buffer | string | number | bigint;
+/** Element of a `keyFlag.tuple` key. */
+export type MDBXTupleElement = Buffer | Uint8Array | string | number | bigint | boolean | null;
+export type MDBXKey = Buffer | string | number | bigint | MDBXTupleElement[];
 export type MDBXValue = Buffer | string | number | bigint;
+/** Typed array keys accepted by `getMany`/`hasMany` on ordinal DBIs. */
+export type MDBXOrdinalKeys = BigUint64Array | BigInt64Array | Float64Array |
+  Float32Array | Uint32Array | Int32Array | Uint16Array | Int16Array |
+  Uint8Array | Int8Array;
 
 export type MDBXCursorMode =
   | number
@@ -54,6 +60,11 @@ export type MDBXEnvGeometry =
   | MDBXEnvGeometryCustom;
 
 export interface MDBXEnvOpenOptions {
+  /**
+   * Environment directory. Opening the same path again in one process (for
+   * example from a `worker_threads` Worker) attaches to the already open
+   * environment; `flags`, `maxDbi` and `changelog` must then be compatible.
+   */
   path: string;
   flags?: number;
   keyFlag?: number;
@@ -71,6 +82,12 @@ export interface MDBXEnvOpenOptions {
    * afterwards.
    */
   trackBorrowedViews?: boolean;
+  /**
+   * Record every put/del/drop issued through this binding into the
+   * `__mdbxmou_changelog` DBI inside the same write transaction.
+   * `true` records keys only, `{ values: true }` also records put values.
+   */
+  changelog?: boolean | { values?: boolean };
 }
 
 declare const mdbxBorrowedView: unique symbol;
@@ -114,6 +131,117 @@ export interface MDBXDbiStat {
   modTxnId: number;
 }
 
+export interface MDBXDbiStatWithFlags extends MDBXDbiStat {
+  /** Database flags as returned by `mdbx_dbi_flags_ex()`. */
+  flags: number;
+}
+
+export interface MDBXEnvInfo {
+  mapSize: number;
+  geometryCurrent: number;
+  geometryUpper: number;
+  lastPgno: number;
+  recentTxnId: number;
+  latterReaderTxnId: number;
+  numReaders: number;
+  maxReaders: number;
+}
+
+export interface MDBXEnvStatOptions {
+  dbis?: MDBX_Dbi[];
+}
+
+export interface MDBXDelRangeOptions<K extends MDBXKey = MDBXKey> extends MDBXRangeOptions<K> {
+  dbi: MDBX_Dbi<K>;
+}
+
+/**
+ * Statistics collected by `MDBX_Env.stat()` from one read snapshot.
+ * `dbis` follows the order of the requested handles.
+ */
+export interface MDBXEnvStatResult {
+  txnId: number;
+  env: MDBXDbiStat;
+  info: MDBXEnvInfo;
+  dbis: MDBXDbiStatWithFlags[];
+}
+
+export interface MDBXCopyProgress {
+  bytesWritten: number;
+  /** Upper bound taken from the used part of the map; compact copies are smaller. */
+  estimatedBytes: number;
+  elapsedMs: number;
+}
+
+export interface MDBXCopyOptions {
+  /** Defaults to `true`, matching the legacy `copyTo(path)` form. */
+  compact?: boolean;
+  /** Replace an existing destination file instead of failing. */
+  overwrite?: boolean;
+  /** Destination write limit; `0` or omitted means unlimited. */
+  maxBytesPerSec?: number;
+  /** Minimum delay between progress callbacks, 1000 ms by default. */
+  progressIntervalMs?: number;
+  /** Throwing from the callback cancels the copy and rejects with that error. */
+  onProgress?: (progress: MDBXCopyProgress) => void;
+}
+
+export interface MDBXCopyResult {
+  bytesWritten: number;
+  elapsedMs: number;
+}
+
+export interface MDBXCopyStreamOptions {
+  /** Defaults to `true`. */
+  compact?: boolean;
+  /** `copyToStream` only: limit of bytes handed to the stream per second. */
+  maxBytesPerSec?: number;
+  /** `copyToStream` only: call `writable.end()` after the last chunk, `true` by default. */
+  end?: boolean;
+}
+
+/** Minimal stream contract used by `copyToStream`, satisfied by `stream.Writable`. */
+export interface MDBXWritableLike {
+  write(chunk: Buffer, callback: (error?: Error | null) => void): unknown;
+  end(): unknown;
+}
+
+export interface MDBXChange {
+  txnId: number;
+  /** Order of the operation inside its transaction. */
+  seq: number;
+  op: 'put' | 'del' | 'clear' | 'drop';
+  /** Same value as `MDBX_Dbi.id` of the affected database. */
+  dbi: bigint;
+  /** Raw key bytes; empty for `clear` and `drop`. */
+  key: Buffer;
+  /** Present when values are recorded, and for deletes of a single multi-value. */
+  value?: Buffer;
+}
+
+export interface MDBXReadChangesOptions {
+  /** Return operations of transactions newer than this one. */
+  sinceTxnid?: number | bigint;
+  /** Soft limit: the last transaction is never split. */
+  limit?: number;
+}
+
+export interface MDBXTrimChangesOptions {
+  /** Keep entries of this transaction and newer ones. */
+  beforeTxnid: number | bigint;
+}
+
+export interface MDBXWatchOptions {
+  /** Upper bound of the idle polling backoff, 50 ms by default. */
+  intervalMs?: number;
+}
+
+export interface MDBXChangesOptions extends MDBXReadChangesOptions {
+  /** Passed to `watch()` while waiting for the next commit. */
+  intervalMs?: number;
+  signal?: AbortSignal;
+}
+
 export interface MDBXMapOptions {
   name?: string;
   keyFlag?: number;
@@ -122,6 +250,39 @@ export interface MDBXMapOptions {
   valueMode?: number;
   flags?: number;
   create?: boolean;
+  /**
+   * In-process Bloom filter for negative `get`/`has`/query lookups, built in
+   * the background. `true` uses 10 bits per key.
+   */
+  bloom?: boolean | { bitsPerKey?: number };
+  /**
+   * LRU cache of `get()` results in read transactions, validated by the DBI
+   * `modTxnId`. `true` allows 1 MiB.
+   */
+  cache?: boolean | { maxBytes?: number };
+}
+
+export interface MDBXCacheStats {
+  hits: number;
+  misses: number;
+  entries: number;
+  bytes: number;
+  maxBytes: number;
+}
+
+export interface MDBXBloomStats {
+  ready: boolean;
+  building: boolean;
+  bitsPerKey: number;
+  capacity: number;
+  keys: number;
+  /** DBI `modTxnId` the filter was built from. */
+  baseTxnId: number;
+  /** Last DBI `modTxnId` the filter is valid for. */
+  coveredTxnId: number;
+  probes: number;
+  negatives: number;
+  builds: number;
 }
 
 /** Result of cursor navigation/search operations */
@@ -138,6 +299,8 @@ export interface MDBXRangeOptions<K extends MDBXKey = MDBXKey> {
   reverse?: boolean;
   includeStart?: boolean;
   includeEnd?: boolean;
+  /** Only keys starting with this prefix (a shorter tuple for `keyFlag.tuple`). */
+  prefix?: K;
 }
 
 /**
@@ -237,7 +400,23 @@ export interface MDBX_Cursor<K extends MDBXKey = MDBXKey, V extends MDBXValue =
    * @returns true if on last value for current key
    */
   onLastMultival(): boolean;
+
+  /**
+   * All duplicates of the current key, or of `key` after seeking to it, read
+   * with `MDBX_GET_MULTIPLE`. `BigUint64Array` for `multiOrdinal`, otherwise
+   * the fixed-size records back to back. Requires an `MDBX_DUPFIXED` DBI.
+   */
+  getDups(key?: MDBXKey): BigUint64Array | Uint8Array | undefined;
   
+  /**
+   * Bind the cursor to another active transaction (`mdbx_cursor_bind`),
+   * releasing the previous one.
+   */
+  renew(txn: MDBX_Txn): void;
+
+  /** Detach the cursor from its transaction so that it can finish. */
+  unbind(): void;
+
   /** 
    * Close cursor. Must be called before transaction commit/abort.
    * Safe to call multiple times.
@@ -266,8 +445,43 @@ export interface MDBX_Dbi<K extends MDBXKey = MDBXKey, V extends MDBXValue = MDB
    * borrowed backing buffer to another JavaScript isolate.
    */
   getView(txn: MDBX_Txn, key: K): MDBX_BorrowedView | undefined;
+  /**
+   * Put `size` uninitialized bytes with `MDBX_RESERVE` and return a writable
+   * view into the dirty page. Requires a write transaction and a single-value
+   * DBI. The view is detached on commit/abort and before the next write made
+   * through the same transaction.
+   */
+  reserve(txn: MDBX_Txn, key: K, size: number): DataView;
+  /**
+   * Rewrite the existing value in place with `MDBX_CURRENT | MDBX_RESERVE`
+   * and return a writable view holding its current bytes, for patching
+   * fixed-layout records. Missing keys return `undefined`. Same lifetime
+   * rules as `reserve()`.
+   */
+  getWritableView(txn: MDBX_Txn, key: K): DataView | undefined;
   del(txn: MDBX_Txn, key: K): boolean;
+  /**
+   * Add `delta` (default 1) to an int64 counter stored in 8 bytes and return
+   * the new value; a missing key counts as 0. Single-value DBIs only.
+   */
+  increment(txn: MDBX_Txn, key: K, delta?: number | bigint): number | bigint;
+  /**
+   * Write `next` only if the current value equals `expected`; `undefined`
+   * means an absent key / delete. Returns whether the swap happened.
+   */
+  compareAndSwap(txn: MDBX_Txn, key: K, expected: V | undefined, next: V | undefined): boolean;
+  /**
+   * Insert all duplicates of `key` with one `MDBX_MULTIPLE` put. Requires
+   * `valueMode.multiOrdinal`; values that already exist are skipped.
+   */
+  putDups(txn: MDBX_Txn, key: K, values: BigUint64Array | Uint32Array | Array<number | bigint>): void;
+  /** Every duplicate of `key` in one typed array, see `MDBX_Cursor.getDups()`. */
+  getAllDups(txn: MDBX_Txn, key: K): BigUint64Array | Uint8Array | undefined;
   has(txn: MDBX_Txn, key: K): boolean;
+  /** Values in input order, `undefined` for missing keys. */
+  getMany(txn: MDBX_Txn, keys: K[] | MDBXOrdinalKeys): Array<V | undefined>;
+  /** Presence bitmap: bit `i` (LSB first) of byte `i >> 3` is set when `keys[i]` exists. */
+  hasMany(txn: MDBX_Txn, keys: K[] | MDBXOrdinalKeys): Uint8Array;
 
   forEach(txn: MDBX_Txn, cb: (key: K, value: V, index: number) => boolean | void): number;
   forEach(
@@ -290,7 +504,16 @@ export interface MDBX_Dbi<K extends MDBXKey = MDBXKey, V extends MDBXValue = MDB
   getCount(txn: MDBX_Txn, options?: MDBXRangeOptions<K>): number;
   keysRange(txn: MDBX_Txn, options?: MDBXRangeOptions<K>): K[];
   valuesRange(txn: MDBX_Txn, options?: MDBXRangeOptions<K>): V[];
+  /**
+   * Delete the keys of a range with one cursor, in a multi-value DBI with all
+   * values. `limit` and `offset` count keys. Returns the number of deleted keys.
+   */
+  delRange(txn: MDBX_Txn, options?: MDBXRangeOptions<K>): number;
   drop(txn: MDBX_Txn, deleteDb?: boolean): void;
+  /** Bloom filter counters, `undefined` when the DBI has no filter. */
+  bloomStats(): MDBXBloomStats | undefined;
+  /** Value cache counters, `undefined` when the DBI has no cache. */
+  cacheStats(): MDBXCacheStats | undefined;
 }
 
 export interface MDBX_Txn {
@@ -331,21 +554,53 @@ export interface MDBX_Txn {
   createMap(name: string, keyMode: number | bigint, valueMode: number): MDBX_Dbi;
   createMap(options: MDBXMapOptions): MDBX_Dbi;
 
+  /**
+   * Run a binary batch of get/put/del/has operations in one native call.
+   * Normally used through `MDBX_Batch`; returns the number of operations
+   * executed before `output` ran out of space.
+   */
+  execute(dbis: MDBX_Dbi[], input: Uint8Array, inputLength: number, output: Uint8Array): number;
+
   /** Open a cursor for the given dbi */
   openCursor<K extends MDBXKey = MDBXKey, V extends MDBXValue = MDBXValue>(
     dbi: MDBX_Dbi<K, V>
   ): MDBX_Cursor<K, V>;
 
   isActive(): boolean;
+  /**
+   * Park a read transaction (`mdbx_txn_park`) so that it stops holding back
+   * GC. Borrowed views are detached. Without `autoUnpark` every access before
+   * `unpark()` fails.
+   */
+  park(options?: { autoUnpark?: boolean }): void;
+  /**
+   * Resume a parked transaction. Returns `true` if it was ousted and
+   * restarted on a newer snapshot (`restartIfOusted`), otherwise throws
+   * `MDBX_OUSTED` for an ousted transaction.
+   */
+  unpark(options?: { restartIfOusted?: boolean }): boolean;
+  isParked(): boolean;
   isTopLevel(): boolean;
 
   startTransaction?: () => MDBX_Txn;
   getChildrenCount?: () => number;
 }
 
+export interface MDBXSnapshot {
+  /** Shared read transaction, valid until `release()`. */
+  readonly txn: MDBX_Txn;
+  /** Drop this reference; the last one retires a stale snapshot. */
+  release(): void;
+}
+
 export interface MDBXQueryItem {
   key: MDBXKey;
-  value?: MDBXValue;
+  /** `queryMode.putDups` takes the duplicates array. */
+  value?: MDBXValue | BigUint64Array | Uint32Array | Array<number | bigint>;
+  /** `queryMode.increment` only, default 1. */
+  delta?: number | bigint;
+  /** `queryMode.compareAndSwap` only, omitted - the key must be absent. */
+  expected?: MDBXValue;
 }
 
 export interface MDBXQueryRequest {
@@ -360,6 +615,10 @@ export interface MDBXQueryResultItem {
   key: MDBXKey;
   value?: MDBXValue | null;
   found?: boolean;
+  /** `queryMode.compareAndSwap`: whether the value was replaced. */
+  swapped?: boolean;
+  /** `queryMode.putDups`: number of values submitted for the key. */
+  count?: number;
 }
 
 export type MDBXQueryResult = MDBXQueryResultItem[] | MDBXQueryResultItem[][];
@@ -384,15 +643,62 @@ export declare class MDBX_Env {
   closeSync(): void;
 
   copyTo(path: string, flags?: number): Promise<void>;
+  /**
+   * Online backup with a write bandwidth limit and progress reports.
+   * Unlike the `flags` form, the environment stays usable while copying.
+   */
+  copyTo(path: string, options: MDBXCopyOptions): Promise<MDBXCopyResult>;
   copyToSync(path: string, flags?: number): void;
+  /** Write a consistent snapshot to an open, writable file descriptor. */
+  copyToFd(fd: number, options?: Pick<MDBXCopyStreamOptions, 'compact'>): Promise<void>;
+  /**
+   * Stream a consistent snapshot into a Writable without a temporary file.
+   * At most four 1 MiB chunks wait for their write callbacks at any time.
+   */
+  copyToStream(writable: MDBXWritableLike, options?: MDBXCopyStreamOptions): Promise<{ bytesWritten: number }>;
 
   version(): string;
 
-  startRead(): MDBX_Txn;
+  /**
+   * `autoParkMs`: park the read transaction (with auto-unpark) after it was
+   * not used for about this many milliseconds, see `MDBX_Txn.park()`.
+   */
+  startRead(options?: { autoParkMs?: number }): MDBX_Txn;
   startWrite(): MDBX_Txn;
+  /**
+   * Shared, refcounted read transaction at most `maxAgeMs` old (default 0).
+   * Call `release()` when done; never commit or abort `txn` directly.
+   * Requires `envFlag.nostickythreads`.
+   */
+  snapshot(options?: { maxAgeMs?: number }): MDBXSnapshot;
 
   query(request: MDBXQueryRequest | MDBXQueryRequest[], txnMode?: number): Promise<MDBXQueryResult>;
   keys(request: MDBXKeysRequest | MDBXKeysRequest[], txnMode?: number): Promise<MDBXKeysResult>;
+  /**
+   * Collect environment totals and per-DBI statistics on a worker thread.
+   * The worker opens its own read transaction, so no JS transaction is needed.
+   */
+  stat(options?: MDBXEnvStatOptions): Promise<MDBXEnvStatResult>;
+  /**
+   * Delete a key range in a write transaction on a worker thread.
+   * Resolves with the number of deleted keys, see `MDBX_Dbi.delRange()`.
+   */
+  delRange<K extends MDBXKey = MDBXKey>(options: MDBXDelRangeOptions<K>): Promise<number>;
+  /** Read a batch of change log entries on a worker thread. */
+  readChanges(options?: MDBXReadChangesOptions): Promise<{ txnId: number; changes: MDBXChange[] }>;
+  /**
+   * Delete change log entries of transactions older than `beforeTxnid` in a
+   * write transaction on a worker thread. Resolves with the number removed.
+   */
+  trimChanges(options: MDBXTrimChangesOptions): Promise<number>;
+  /**
+   * Call `callback` with the latest committed txnid whenever it advances,
+   * including commits made by other processes. Returns a stop function;
+   * closing the environment stops all watchers.
+   */
+  watch(callback: (txnId: number) => void, options?: MDBXWatchOptions): () => void;
+  /** Tail the change log until `signal` aborts. */
+  changes(options?: MDBXChangesOptions): AsyncGenerator<MDBXChange, void, undefined>;
   /** syncPeriod expects seconds and may be fractional; other options use integer values. */
   setOption(option: number, value: number | bigint): void;
   syncEx(force: boolean, nonblock: boolean): number;
@@ -453,12 +759,18 @@ export interface MDBX_Param {
   readonly keyMode: {
     readonly reverse: number;
     readonly ordinal: number;
+    /** Signed 64-bit integer keys (Number or BigInt), ordered numerically. */
+    readonly int64: number;
+    /** Double keys, ordered numerically; NaN is rejected. */
+    readonly float64: number;
   };
 
   readonly keyFlag: {
     readonly string: number;
     readonly number: number;
     readonly bigint: number;
+    /** Keys are arrays stored in an order-preserving tuple encoding. */
+    readonly tuple: number;
   };
 
   readonly valueMode: {
@@ -473,6 +785,8 @@ export interface MDBX_Param {
     readonly string: number;
     readonly number: number;
     readonly bigint: number;
+    /** Values are JS objects stored as MessagePack. */
+    readonly object: number;
   };
 
   readonly dbMode: {
@@ -486,6 +800,9 @@ export interface MDBX_Param {
     readonly insertUnique: number;
     readonly get: number;
     readonly del: number;
+    readonly increment: number;
+    readonly compareAndSwap: number;
+    readonly putDups: number;
   };
 
   readonly putFlag: {
@@ -520,7 +837,25 @@ export interface MDBX_Param {
 /** Runtime constants exported by the native module. */
 export declare const MDBX_Param: MDBX_Param;
 
+/**
+ * Reusable buffer of get/put/del/has operations executed with one
+ * `txn.execute()` call. Keys and values follow the DBI flags; tuple keys
+ * and object values are not supported.
+ */
+export declare class MDBX_Batch {
+  constructor(options?: { inputSize?: number; outputSize?: number });
+  readonly length: number;
+  get(dbi: MDBX_Dbi, key: MDBXKey): this;
+  has(dbi: MDBX_Dbi, key: MDBXKey): this;
+  del(dbi: MDBX_Dbi, key: MDBXKey): this;
+  put(dbi: MDBX_Dbi, key: MDBXKey, value: MDBXValue, flags?: number): this;
+  /** Results by operation index: get - value or undefined, others - boolean. */
+  execute(txn: MDBX_Txn): Array<MDBXValue | boolean | undefined>;
+  clear(): this;
+}
+
 export interface MDBX_Native {
   MDBX_Env: typeof MDBX_Env;
   MDBX_Param: typeof MDBX_Param;
+  MDBX_Batch: typeof MDBX_Batch;
 }
@@ -0,0 +1,262 @@
+#include "copy_pump.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mdbxmou {
+
+namespace {
+
+#ifdef _WIN32
+
+int last_error() noexcept
+{
+    return static_cast<int>(GetLastError());
+}
+
+void open_pipe(mdbx_filehandle_t fds[2], std::size_t chunk_size)
+{
+    if (!CreatePipe(&fds[0], &fds[1], nullptr,
+        static_cast<DWORD>(chunk_size))) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+void close_handle(mdbx_filehandle_t fd) noexcept
+{
+    CloseHandle(fd);
+}
+
+// 0 - конец данных, < 0 - ошибка
+std::ptrdiff_t read_pipe(mdbx_filehandle_t fd, char* data, std::size_t size)
+{
+    DWORD n{};
+    if (!ReadFile(fd, data, static_cast<DWORD>(size), &n, nullptr)) {
+        auto rc = GetLastError();
+        return (rc == ERROR_BROKEN_PIPE) ? 0 : -1;
+    }
+    return static_cast<std::ptrdiff_t>(n);
+}
+
+#else
+
+int last_error() noexcept
+{
+    return errno;
+}
+
+void open_pipe(mdbx_filehandle_t fds[2], std::size_t)
+{
+    if (::pipe(fds) != 0) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+void close_handle(mdbx_filehandle_t fd) noexcept
+{
+    ::close(fd);
+}
+
+std::ptrdiff_t read_pipe(mdbx_filehandle_t fd, char* data, std::size_t size)
+{
+    for (;;) {
+        auto n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return n;
+    }
+}
+
+#endif
+
+} // namespace
+
+int copy_pump::run(std::size_t chunk_size, const sink& fn)
+{
+    mdbx_filehandle_t fds[2];
+    open_pipe(fds, chunk_size);
+
+    // сброс на диск делает получатель, pipe синхронизировать незачем
+    auto flags = static_cast<MDBX_copy_flags_t>(flags_ | MDBX_CP_DONT_FLUSH);
+    int copy_rc{MDBX_SUCCESS};
+    std::thread copier{[&] {
+        copy_rc = mdbx_env_copy2fd(env_, fds[1], flags);
+        close_handle(fds[1]);
+    }};
+
+    // закрытие читающего конца обрывает запись в pipe (EPIPE),
+    // поэтому копирующий поток всегда завершится
+    auto finish = [&] {
+        close_handle(fds[0]);
+        copier.join();
+    };
+
+    std::vector<char> buf(chunk_size);
+    std::size_t fill{};
+    bool stopped{false};
+    int read_rc{MDBX_SUCCESS};
+    try {
+        for (;;) {
+            auto n = read_pipe(fds[0], buf.data() + fill, buf.size() - fill);
+            if (n < 0) {
+                read_rc = last_error();
+                break;
+            }
+            if (n == 0) {
+                break;
+            }
+            fill += static_cast<std::size_t>(n);
+            if (fill == buf.size()) {
+                if (!fn(buf.data(), fill)) {
+                    stopped = true;
+                    break;
+                }
+                fill = 0;
+            }
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+
+    finish();
+
+    if (stopped) {
+        return MDBX_RESULT_TRUE;
+    }
+    if (read_rc != MDBX_SUCCESS) {
+        return read_rc;
+    }
+    if (copy_rc != MDBX_SUCCESS) {
+        return copy_rc;
+    }
+    if (fill && !fn(buf.data(), fill)) {
+        return MDBX_RESULT_TRUE;
+    }
+    return MDBX_SUCCESS;
+}
+
+copy_pacer::copy_pacer(std::uint64_t bytes_per_sec,
+    std::uint64_t burst) noexcept
+    : bytes_per_sec_{bytes_per_sec}
+    , budget_{burst}
+    , started_us_{now_us()}
+{   }
+
+std::int64_t copy_pacer::now_us() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+void copy_pacer::acquire(std::size_t size)
+{
+    if (!bytes_per_sec_) {
+        return;
+    }
+
+    spent_ += size;
+    auto elapsed = static_cast<double>(now_us() - started_us_) / 1e6;
+    auto allowed = static_cast<double>(budget_) +
+        elapsed * static_cast<double>(bytes_per_sec_);
+    auto excess = static_cast<double>(spent_) - allowed;
+    if (excess > 0) {
+        auto wait_us = excess * 1e6 / static_cast<double>(bytes_per_sec_);
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(static_cast<std::int64_t>(wait_us)));
+    }
+}
+
+#ifdef _WIN32
+
+copy_file::copy_file(const std::string& path, bool overwrite)
+{
+    auto len = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring wpath(len > 0 ? len : 0, L'\0');
+    if (len > 0) {
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wpath.data(), len);
+    }
+    fd_ = CreateFileW(wpath.c_str(), GENERIC_WRITE, 0, nullptr,
+        overwrite ? CREATE_ALWAYS : CREATE_NEW,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fd_ == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+copy_file::~copy_file()
+{
+    CloseHandle(fd_);
+}
+
+void copy_file::write(const char* data, std::size_t size)
+{
+    while (size) {
+        DWORD n{};
+        if (!WriteFile(fd_, data, static_cast<DWORD>(size), &n, nullptr)) {
+            throw std::runtime_error(mdbx_strerror(last_error()));
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+void copy_file::flush()
+{
+    if (!FlushFileBuffers(fd_)) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+#else
+
+copy_file::copy_file(const std::string& path, bool overwrite)
+{
+    auto mode = O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_EXCL);
+    fd_ = ::open(path.c_str(), mode | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+copy_file::~copy_file()
+{
+    ::close(fd_);
+}
+
+void copy_file::write(const char* data, std::size_t size)
+{
+    while (size) {
+        auto n = ::write(fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(mdbx_strerror(last_error()));
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+void copy_file::flush()
+{
+    if (::fsync(fd_) != 0) {
+        throw std::runtime_error(mdbx_strerror(last_error()));
+    }
+}
+
+#endif
+
+} // namespace mdbxmou
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <mdbx.h++>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace mdbxmou {
+
+// Копирование окружения через pipe: mdbx_env_copy2fd() пишет снимок
+// в отдельном потоке, а вызывающий поток получает страницы кусками
+// и сам решает куда и с какой скоростью их отдавать.
+class copy_pump
+{
+public:
+    // false из sink прерывает копирование
+    using sink = std::function<bool(const char* data, std::size_t size)>;
+
+    copy_pump(MDBX_env* env, MDBX_copy_flags_t flags) noexcept
+        : env_{env}
+        , flags_{flags}
+    {   }
+
+    // возвращает код mdbx_env_copy2fd(),
+    // при остановке со стороны sink - MDBX_RESULT_TRUE
+    int run(std::size_t chunk_size, const sink& fn);
+
+private:
+    MDBX_env* env_{};
+    MDBX_copy_flags_t flags_{MDBX_CP_DEFAULTS};
+};
+
+// Ограничитель скорости записи (token bucket с одним куском запаса)
+class copy_pacer
+{
+    std::uint64_t bytes_per_sec_{};
+    std::uint64_t budget_{};
+    std::uint64_t spent_{};
+    std::int64_t started_us_{};
+
+public:
+    explicit copy_pacer(std::uint64_t bytes_per_sec,
+        std::uint64_t burst) noexcept;
+
+    // ждет, пока бюджет позволит отдать size байт
+    void acquire(std::size_t size);
+
+    static std::int64_t now_us() noexcept;
+};
+
+// Файл назначения для копирования, закрывается в деструкторе
+class copy_file
+{
+    mdbx_filehandle_t fd_;
+
+public:
+    copy_file(const std::string& path, bool overwrite);
+    ~copy_file();
+
+    copy_file(const copy_file&) = delete;
+    copy_file& operator=(const copy_file&) = delete;
+
+    void write(const char* data, std::size_t size);
+    void flush();
+};
+
+} // namespace mdbxmou
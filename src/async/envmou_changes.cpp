@@ -0,0 +1,212 @@
+#include "envmou_changes.hpp"
+#include "changelog.hpp"
+#include "dbi.hpp"
+#include "envmou.hpp"
+#include <cmath>
+
+namespace mdbxmou {
+
+static std::uint64_t parse_txnid(const Napi::Value& value,
+    const char* method, const char* name)
+{
+    auto env = value.Env();
+    if (value.IsBigInt()) {
+        bool lossless{};
+        auto rc = value.As<Napi::BigInt>().Uint64Value(&lossless);
+        if (!lossless) {
+            throw Napi::RangeError::New(env,
+                std::string(method) + ": " + name + " must fit uint64");
+        }
+        return rc;
+    }
+    if (value.IsNumber()) {
+        auto rc = value.As<Napi::Number>().DoubleValue();
+        if (!std::isfinite(rc) || rc < 0) {
+            throw Napi::RangeError::New(env,
+                std::string(method) + ": " + name + " must be >= 0");
+        }
+        return static_cast<std::uint64_t>(rc);
+    }
+    throw Napi::TypeError::New(env,
+        std::string(method) + ": " + name + " must be a number");
+}
+
+changes_request parse_changes(const Napi::Value& arg0)
+{
+    changes_request rc{};
+    if (arg0.IsUndefined() || arg0.IsNull()) {
+        return rc;
+    }
+
+    auto env = arg0.Env();
+    if (!arg0.IsObject()) {
+        throw Napi::TypeError::New(env, 
+            "readChanges: expected { sinceTxnid?, limit? }");
+    }
+    auto obj = arg0.As<Napi::Object>();
+
+    auto since = obj.Get("sinceTxnid");
+    if (!since.IsUndefined()) {
+        rc.since_txnid = parse_txnid(since, "readChanges", "sinceTxnid");
+    }
+
+    auto limit = obj.Get("limit");
+    if (limit.IsNumber()) {
+        auto value = limit.As<Napi::Number>().DoubleValue();
+        if (!std::isfinite(value) || value < 1) {
+            throw Napi::RangeError::New(env, "readChanges: limit must be >= 1");
+        }
+        rc.limit = static_cast<std::size_t>(value);
+    } else if (!limit.IsUndefined()) {
+        throw Napi::TypeError::New(env, "readChanges: limit must be a number");
+    }
+
+    return rc;
+}
+
+range_options parse_trim_changes(const Napi::Value& arg0)
+{
+    auto env = arg0.Env();
+    if (!arg0.IsObject()) {
+        throw Napi::TypeError::New(env,
+            "trimChanges: expected { beforeTxnid }");
+    }
+    auto before = arg0.As<Napi::Object>().Get("beforeTxnid");
+    if (before.IsUndefined()) {
+        throw Napi::TypeError::New(env,
+            "trimChanges: beforeTxnid is required");
+    }
+
+    // все записи транзакций старше beforeTxnid: [начало, (beforeTxnid, 0))
+    range_options rc{};
+    rc.has_end = true;
+    rc.include_end = false;
+    rc.end_buf.resize(changelog::key_size);
+    changelog::encode_key(parse_txnid(before, "trimChanges", "beforeTxnid"),
+        0, rc.end_buf.data());
+    return rc;
+}
+
+void async_changes::Execute()
+{
+    try {
+        MDBX_txn* ptr;
+        mdbx::error::success_or_throw(::mdbx_txn_begin(
+            env_, nullptr, MDBX_TXN_RDONLY, &ptr));
+        txnmou_managed txn{ptr};
+        txn_id_ = ::mdbx_txn_id(txn);
+
+        // только для чтения журнал мог появиться после открытия
+        if (!log_dbi_) {
+            auto rc = ::mdbx_dbi_open(txn, changelog::map_name,
+                MDBX_DB_DEFAULTS, &log_dbi_);
+            if (rc == MDBX_NOTFOUND) {
+                log_dbi_ = 0;
+            } else {
+                mdbx::error::success_or_throw(rc);
+            }
+        }
+
+        if (log_dbi_) {
+            auto cursor = dbi::open_cursor(txn, mdbx::map_handle{log_dbi_});
+
+            // первая операция транзакции since_txnid + 1
+            char from[changelog::key_size];
+            changelog::encode_key(query_.since_txnid + 1, 0, from);
+            MDBX_val key{from, sizeof(from)};
+            MDBX_val val{};
+            auto rc = ::mdbx_cursor_get(cursor, &key, &val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                auto e = changelog::decode(key, val);
+                // транзакцию отдаем целиком, иначе следующий запрос с
+                // sinceTxnid = последний txnid потеряет ее остаток
+                if (result_.size() >= query_.limit &&
+                    e.txnid != result_.back().txnid) {
+                    break;
+                }
+
+                change_line line{};
+                line.txnid = e.txnid;
+                line.seq = e.seq;
+                line.op = e.kind;
+                line.dbi = e.dbi;
+                line.key.assign(e.key.char_ptr(), e.key.end_char_ptr());
+                line.has_value = e.has_value;
+                if (e.has_value) {
+                    line.value.assign(e.value.char_ptr(), e.value.end_char_ptr());
+                }
+                result_.push_back(std::move(line));
+
+                rc = ::mdbx_cursor_get(cursor, &key, &val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                mdbx::error::throw_exception(rc);
+            }
+        }
+
+        txn.commit();
+    } catch (const std::exception& e) {
+        SetError(e.what());
+    } catch (...) {
+        SetError("async_changes::Execute");
+    }
+}
+
+static const char* op_name(std::uint8_t op) noexcept
+{
+    switch (op) {
+    case changelog::put:
+        return "put";
+    case changelog::del:
+        return "del";
+    case changelog::clear:
+        return "clear";
+    case changelog::drop:
+        return "drop";
+    }
+    return "unknown";
+}
+
+void async_changes::OnOK()
+{
+    --env_;
+
+    Napi::Env env = Env();
+
+    auto changes = Napi::Array::New(env, result_.size());
+    for (std::size_t i = 0; i < result_.size(); ++i) {
+        const auto& line = result_[i];
+        auto js_line = Napi::Object::New(env);
+        js_line.Set("txnId", Napi::Number::New(env, 
+            static_cast<double>(line.txnid)));
+        js_line.Set("seq", Napi::Number::New(env, 
+            static_cast<double>(line.seq)));
+        js_line.Set("op", Napi::String::New(env, op_name(line.op)));
+        // тот же тип, что у dbi.id
+        js_line.Set("dbi", Napi::BigInt::New(env, 
+            static_cast<std::uint64_t>(line.dbi)));
+        js_line.Set("key", Napi::Buffer<char>::Copy(env, 
+            line.key.data(), line.key.size()));
+        if (line.has_value) {
+            js_line.Set("value", Napi::Buffer<char>::Copy(env, 
+                line.value.data(), line.value.size()));
+        }
+        changes.Set(static_cast<uint32_t>(i), js_line);
+    }
+
+    auto result = Napi::Object::New(env);
+    result.Set("txnId", Napi::Number::New(env, 
+        static_cast<double>(txn_id_)));
+    result.Set("changes", changes);
+
+    deferred_.Resolve(result);
+}
+
+void async_changes::OnError(const Napi::Error& e)
+{
+    --env_;
+
+    deferred_.Reject(e.Value());
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "querymou.hpp"
+#include "rangemou.hpp"
+
+namespace mdbxmou {
+
+class envmou;
+
+struct changes_request
+{
+    // вернуть операции транзакций новее этой
+    std::uint64_t since_txnid{};
+    // транзакция не разрывается, поэтому limit может быть превышен
+    std::size_t limit{1024};
+};
+
+changes_request parse_changes(const Napi::Value& arg0);
+
+// trimChanges({ beforeTxnid }) - диапазон журнала для delete_range
+range_options parse_trim_changes(const Napi::Value& arg0);
+
+struct change_line
+{
+    std::uint64_t txnid{};
+    std::uint64_t seq{};
+    std::uint8_t op{};
+    MDBX_dbi dbi{};
+    buffer_type key{};
+    buffer_type value{};
+    bool has_value{false};
+};
+
+class async_changes
+    : public Napi::AsyncWorker
+{
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    MDBX_dbi log_dbi_{};
+    changes_request query_{};
+    std::vector<change_line> result_{};
+    std::uint64_t txn_id_{};
+
+public:
+    async_changes(Napi::Env env, envmou& e, 
+        MDBX_dbi log_dbi, changes_request query)
+        : Napi::AsyncWorker{env}
+        , deferred_{Napi::Promise::Deferred::New(env)}
+        , env_{e}
+        , log_dbi_{log_dbi}
+        , query_{query}
+    {   }
+
+    void Execute() override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+};
+
+} // namespace mdbxmou
@@ -0,0 +1,231 @@
+#include "envmou_copy_stream.hpp"
+#include "copy_pump.hpp"
+#include "envmou.hpp"
+#include <cmath>
+#include <memory>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#endif
+
+namespace mdbxmou {
+
+mdbx_filehandle_t parse_copy_fd(const Napi::Value& arg0)
+{
+    auto env = arg0.Env();
+    if (!arg0.IsNumber()) {
+        throw Napi::TypeError::New(env, "copyToFd: fd must be a number");
+    }
+    auto value = arg0.As<Napi::Number>().DoubleValue();
+    if (!std::isfinite(value) || value < 0 || value != std::floor(value) ||
+        value > 2147483647.0) {
+        throw Napi::RangeError::New(env, "copyToFd: invalid file descriptor");
+    }
+    auto fd = static_cast<int>(value);
+#ifdef _WIN32
+    auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw Napi::RangeError::New(env, "copyToFd: invalid file descriptor");
+    }
+    return handle;
+#else
+    return fd;
+#endif
+}
+
+copy_stream_options parse_copy_stream_options(const Napi::Value& arg0,
+    const char* method)
+{
+    copy_stream_options rc{};
+    if (arg0.IsUndefined() || arg0.IsNull()) {
+        return rc;
+    }
+
+    auto env = arg0.Env();
+    if (!arg0.IsObject()) {
+        throw Napi::TypeError::New(env,
+            std::string(method) + ": options must be an object");
+    }
+    auto obj = arg0.As<Napi::Object>();
+
+    auto compact = obj.Get("compact");
+    if (!compact.IsUndefined() && !compact.ToBoolean().Value()) {
+        rc.flags = MDBX_CP_DEFAULTS;
+    }
+
+    auto end = obj.Get("end");
+    if (!end.IsUndefined()) {
+        rc.end = end.ToBoolean().Value();
+    }
+
+    auto limit = obj.Get("maxBytesPerSec");
+    if (!limit.IsUndefined()) {
+        auto value = limit.IsNumber() ?
+            limit.As<Napi::Number>().DoubleValue() : -1.0;
+        if (!std::isfinite(value) || value < 0) {
+            throw Napi::RangeError::New(env, std::string(method) +
+                ": maxBytesPerSec must be a non-negative number");
+        }
+        rc.max_bytes_per_sec = static_cast<std::uint64_t>(value);
+    }
+
+    return rc;
+}
+
+void async_copy_fd::Execute()
+{
+    auto rc = mdbx_env_copy2fd(env_, fd_, flags_);
+    if (rc != MDBX_SUCCESS) {
+        SetError(mdbx_strerror(rc));
+    }
+}
+
+void async_copy_fd::OnOK()
+{
+    --env_;
+    deferred_.Resolve(Env().Undefined());
+}
+
+void async_copy_fd::OnError(const Napi::Error& e)
+{
+    --env_;
+    deferred_.Reject(e.Value());
+}
+
+async_copy_stream::async_copy_stream(Napi::Env env, envmou& e,
+    Napi::Object writable, copy_stream_options opt)
+    : Napi::AsyncWorker{env}
+    , deferred_{Napi::Promise::Deferred::New(env)}
+    , env_{e}
+    , writable_{Napi::Persistent(writable)}
+    , opt_{opt}
+{
+    tsfn_ = tsfn_type::New(env, "mdbxmou.copyToStream", 0, 1, this);
+}
+
+void async_copy_stream::acknowledge(Napi::Env env, napi_value err)
+{
+    bool failed{true};
+    if (env != nullptr) {
+        Napi::Value value{env, err};
+        failed = !value.IsEmpty() && !value.IsUndefined() && !value.IsNull();
+        if (failed && write_error_.IsEmpty()) {
+            write_error_ = Napi::Persistent(value);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        --in_flight_;
+        if (failed) {
+            cancelled_ = true;
+        }
+    }
+    cv_.notify_all();
+}
+
+void async_copy_stream::call_js(Napi::Env env, Napi::Function,
+    async_copy_stream* self, chunk* data)
+{
+    std::unique_ptr<chunk> guard{data};
+    if (env == nullptr) {
+        // окружение node завершается, писать некуда
+        self->acknowledge(env, nullptr);
+        return;
+    }
+
+    try {
+        auto buf = Napi::Buffer<char>::Copy(env, data->data(), data->size());
+        guard.reset();
+
+        auto writable = self->writable_.Value();
+        auto done = Napi::Function::New(env,
+            [self](const Napi::CallbackInfo& info) {
+                self->acknowledge(info.Env(), info[0]);
+            });
+        writable.Get("write").As<Napi::Function>().Call(writable, {buf, done});
+    } catch (const Napi::Error& e) {
+        self->acknowledge(env, e.Value());
+    }
+}
+
+void async_copy_stream::Execute()
+{
+    try {
+        copy_pacer pacer{opt_.max_bytes_per_sec, chunk_size};
+        copy_pump pump{env_, opt_.flags};
+        auto rc = pump.run(chunk_size, [&](const char* data, std::size_t size) {
+            {
+                std::unique_lock<std::mutex> l(mutex_);
+                cv_.wait(l, [&] {
+                    return cancelled_.load() || in_flight_ < max_in_flight;
+                });
+                if (cancelled_) {
+                    return false;
+                }
+                ++in_flight_;
+            }
+
+            pacer.acquire(size);
+
+            auto* c = new chunk(data, data + size);
+            if (tsfn_.BlockingCall(c) != napi_ok) {
+                delete c;
+                std::lock_guard<std::mutex> l(mutex_);
+                --in_flight_;
+                cancelled_ = true;
+                return false;
+            }
+            bytes_written_ += size;
+            return true;
+        });
+
+        // все отправленные куски должны быть подтверждены до OnOK
+        {
+            std::unique_lock<std::mutex> l(mutex_);
+            cv_.wait(l, [&] { return in_flight_ == 0; });
+        }
+
+        if (rc == MDBX_RESULT_TRUE) {
+            SetError("cancelled");
+        } else if (rc != MDBX_SUCCESS) {
+            SetError(mdbx_strerror(rc));
+        }
+    } catch (const std::exception& e) {
+        SetError(e.what());
+    }
+
+    tsfn_.Release();
+}
+
+void async_copy_stream::OnOK()
+{
+    --env_;
+    auto env = Env();
+    try {
+        if (opt_.end) {
+            auto writable = writable_.Value();
+            writable.Get("end").As<Napi::Function>().Call(writable, {});
+        }
+    } catch (const Napi::Error& e) {
+        deferred_.Reject(e.Value());
+        return;
+    }
+
+    auto obj = Napi::Object::New(env);
+    obj.Set("bytesWritten", Napi::Number::New(env, static_cast<double>(bytes_written_)));
+    deferred_.Resolve(obj);
+}
+
+void async_copy_stream::OnError(const Napi::Error& e)
+{
+    --env_;
+    if (!write_error_.IsEmpty()) {
+        deferred_.Reject(write_error_.Value());
+        return;
+    }
+    deferred_.Reject(e.Value());
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,108 @@
+#pragma once
+#include <napi.h>
+#include <mdbx.h++>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mdbxmou {
+
+class envmou;
+
+// копия окружения в открытый файловый дескриптор
+class async_copy_fd
+    : public Napi::AsyncWorker
+{
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    mdbx_filehandle_t fd_;
+    MDBX_copy_flags_t flags_{MDBX_CP_COMPACT};
+
+public:
+    async_copy_fd(Napi::Env env, envmou& e,
+        mdbx_filehandle_t fd, MDBX_copy_flags_t flags)
+        : Napi::AsyncWorker{env}
+        , deferred_{Napi::Promise::Deferred::New(env)}
+        , env_{e}
+        , fd_{fd}
+        , flags_{flags}
+    {   }
+
+    void Execute() override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+};
+
+mdbx_filehandle_t parse_copy_fd(const Napi::Value& arg0);
+
+struct copy_stream_options
+{
+    MDBX_copy_flags_t flags{MDBX_CP_COMPACT};
+    std::uint64_t max_bytes_per_sec{};
+    // вызвать writable.end() после последнего куска
+    bool end{true};
+};
+
+// method - имя вызова для текста ошибок (copyToFd, copyToStream)
+copy_stream_options parse_copy_stream_options(const Napi::Value& arg0,
+    const char* method);
+
+// копия окружения в Node Writable: страницы из pipe уходят кусками
+// через writable.write(), число неподтвержденных кусков ограничено
+class async_copy_stream
+    : public Napi::AsyncWorker
+{
+public:
+    using chunk = std::vector<char>;
+
+    static constexpr std::size_t chunk_size = 1u << 20;
+    static constexpr std::size_t max_in_flight = 4;
+
+private:
+    static void call_js(Napi::Env env, Napi::Function,
+        async_copy_stream* self, chunk* data);
+
+    using tsfn_type = Napi::TypedThreadSafeFunction<
+        async_copy_stream, chunk, &async_copy_stream::call_js>;
+
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    Napi::ObjectReference writable_{};
+    copy_stream_options opt_{};
+    tsfn_type tsfn_{};
+
+    std::mutex mutex_{};
+    std::condition_variable cv_{};
+    std::size_t in_flight_{};
+    std::atomic<bool> cancelled_{false};
+    std::uint64_t bytes_written_{};
+    // ошибка из колбэка writable.write()
+    Napi::Reference<Napi::Value> write_error_{};
+
+    // подтверждение куска из колбэка write(), env == nullptr при завершении node
+    void acknowledge(Napi::Env env, napi_value err);
+
+public:
+    async_copy_stream(Napi::Env env, envmou& e,
+        Napi::Object writable, copy_stream_options opt);
+
+    void Execute() override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+};
+
+} // namespace mdbxmou
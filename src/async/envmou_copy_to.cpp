@@ -1,5 +1,9 @@
 #include "envmou_copy_to.hpp"
+#include "copy_pump.hpp"
 #include "envmou.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 
 namespace mdbxmou {
 
@@ -23,4 +27,193 @@ void async_copy::OnError(const Napi::Error& e)
     deferred_.Reject(e.Value());
 }    
 
-} // namespace mdbxmou
\ No newline at end of file
+copy_options parse_copy_options(const Napi::Value& arg0)
+{
+    auto env = arg0.Env();
+    copy_options rc{};
+    auto obj = arg0.As<Napi::Object>();
+
+    auto compact = obj.Get("compact");
+    if (!compact.IsUndefined() && !compact.ToBoolean().Value()) {
+        rc.flags = MDBX_CP_DEFAULTS;
+    }
+    if (obj.Get("overwrite").ToBoolean().Value()) {
+        rc.flags = static_cast<MDBX_copy_flags_t>(rc.flags | MDBX_CP_OVERWRITE);
+    }
+
+    auto limit = obj.Get("maxBytesPerSec");
+    if (!limit.IsUndefined()) {
+        auto value = limit.IsNumber() ? 
+            limit.As<Napi::Number>().DoubleValue() : -1.0;
+        if (!std::isfinite(value) || value < 0) {
+            throw Napi::RangeError::New(env, 
+                "copyTo: maxBytesPerSec must be a non-negative number");
+        }
+        rc.max_bytes_per_sec = static_cast<std::uint64_t>(value);
+    }
+
+    auto interval = obj.Get("progressIntervalMs");
+    if (!interval.IsUndefined()) {
+        auto value = interval.IsNumber() ? 
+            interval.As<Napi::Number>().DoubleValue() : -1.0;
+        if (!std::isfinite(value) || value < 0 || value > 3600000.0) {
+            throw Napi::RangeError::New(env, 
+                "copyTo: progressIntervalMs is out of range");
+        }
+        rc.progress_interval_ms = static_cast<std::uint32_t>(value);
+    }
+
+    auto cb = obj.Get("onProgress");
+    if (!cb.IsUndefined()) {
+        if (!cb.IsFunction()) {
+            throw Napi::TypeError::New(env, "copyTo: onProgress must be a function");
+        }
+        rc.on_progress = cb.As<Napi::Function>();
+    }
+
+    return rc;
+}
+
+async_copy_paced::async_copy_paced(Napi::Env env, envmou& e,
+    std::string dest, copy_options opt)
+    : Napi::AsyncProgressWorker<copy_progress>{env}
+    , deferred_{Napi::Promise::Deferred::New(env)}
+    , env_{e}
+    , dest_{std::move(dest)}
+    , flags_{opt.flags}
+    , max_bytes_per_sec_{opt.max_bytes_per_sec}
+    , progress_interval_ms_{opt.progress_interval_ms}
+{
+    if (!opt.on_progress.IsEmpty()) {
+        on_progress_ = Napi::Persistent(opt.on_progress);
+    }
+}
+
+void async_copy_paced::Execute(const ExecutionProgress& progress)
+{
+    bool created{false};
+    try {
+        MDBX_envinfo info{};
+        auto rc = mdbx_env_info_ex(env_, nullptr, &info, sizeof(info));
+        if (rc != MDBX_SUCCESS) {
+            throw std::runtime_error(mdbx_strerror(rc));
+        }
+        std::size_t page_size = info.mi_dxb_pagesize;
+        // при compact размер копии меньше, оценка сверху
+        copy_progress p{};
+        p.estimated_bytes = (info.mi_last_pgno + 1) * page_size;
+
+        // кусок записи кратен странице: 1 МиБ или ~1/16 секундного бюджета
+        std::size_t chunk = 1u << 20;
+        if (max_bytes_per_sec_) {
+            auto slice = static_cast<std::size_t>(max_bytes_per_sec_ / 16);
+            chunk = std::clamp<std::size_t>(slice, page_size, chunk);
+        }
+        chunk = std::max(page_size, chunk / page_size * page_size);
+
+        // флаг перезаписи относится к файлу назначения, не к mdbx_env_copy2fd()
+        bool overwrite = (flags_ & MDBX_CP_OVERWRITE) != 0;
+        auto flags = static_cast<MDBX_copy_flags_t>(flags_ & ~MDBX_CP_OVERWRITE);
+        if (max_bytes_per_sec_) {
+            // медленная копия не должна держать переработку старых страниц
+            flags = static_cast<MDBX_copy_flags_t>(flags | MDBX_CP_THROTTLE_MVCC);
+        }
+
+        auto started = copy_pacer::now_us();
+        auto interval = static_cast<std::int64_t>(progress_interval_ms_) * 1000;
+        auto next_report = started + interval;
+        bool want_progress = !on_progress_.IsEmpty();
+        {
+            copy_file file{dest_, overwrite};
+            created = true;
+            copy_pacer pacer{max_bytes_per_sec_, chunk};
+            copy_pump pump{env_, flags};
+            rc = pump.run(chunk, [&](const char* data, std::size_t size) {
+                if (cancelled_.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                pacer.acquire(size);
+                file.write(data, size);
+                p.bytes_written += size;
+                if (want_progress) {
+                    auto now = copy_pacer::now_us();
+                    if (now >= next_report) {
+                        p.elapsed_ms = (now - started) / 1000;
+                        progress.Send(&p, 1);
+                        next_report = now + interval;
+                    }
+                }
+                return true;
+            });
+            if (rc == MDBX_RESULT_TRUE) {
+                throw std::runtime_error("cancelled");
+            }
+            if (rc != MDBX_SUCCESS) {
+                throw std::runtime_error(mdbx_strerror(rc));
+            }
+            file.flush();
+        }
+        p.elapsed_ms = (copy_pacer::now_us() - started) / 1000;
+        last_ = p;
+    } catch (const std::exception& e) {
+        if (created) {
+            std::remove(dest_.c_str());
+        }
+        SetError(e.what());
+    }
+}
+
+void async_copy_paced::report(const copy_progress& p)
+{
+    if (on_progress_.IsEmpty() || cancelled_.load()) {
+        return;
+    }
+
+    auto env = Env();
+    auto obj = Napi::Object::New(env);
+    obj.Set("bytesWritten", Napi::Number::New(env, static_cast<double>(p.bytes_written)));
+    obj.Set("estimatedBytes", Napi::Number::New(env, static_cast<double>(p.estimated_bytes)));
+    obj.Set("elapsedMs", Napi::Number::New(env, static_cast<double>(p.elapsed_ms)));
+    try {
+        on_progress_.Call({obj});
+    } catch (const Napi::Error& e) {
+        progress_error_ = Napi::Persistent(e.Value());
+        cancelled_.store(true);
+    }
+}
+
+void async_copy_paced::OnProgress(const copy_progress* data, std::size_t count)
+{
+    if (data && count) {
+        report(data[count - 1]);
+    }
+}
+
+void async_copy_paced::OnOK()
+{
+    --env_;
+    // финальный отчет всегда совпадает с итогом копирования
+    report(last_);
+
+    auto env = Env();
+    if (!progress_error_.IsEmpty()) {
+        deferred_.Reject(progress_error_.Value());
+        return;
+    }
+    auto obj = Napi::Object::New(env);
+    obj.Set("bytesWritten", Napi::Number::New(env, static_cast<double>(last_.bytes_written)));
+    obj.Set("elapsedMs", Napi::Number::New(env, static_cast<double>(last_.elapsed_ms)));
+    deferred_.Resolve(obj);
+}
+
+void async_copy_paced::OnError(const Napi::Error& e)
+{
+    --env_;
+    if (!progress_error_.IsEmpty()) {
+        deferred_.Reject(progress_error_.Value());
+        return;
+    }
+    deferred_.Reject(e.Value());
+}
+
+} // namespace mdbxmou
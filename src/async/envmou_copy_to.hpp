@@ -1,6 +1,8 @@
 #pragma once
 #include <napi.h>
 #include <mdbx.h++>
+#include <atomic>
+#include <cstdint>
 
 namespace mdbxmou {
 
@@ -35,4 +37,59 @@ public:
     }
 };
 
-} // namespace mdbxmou
\ No newline at end of file
+struct copy_options
+{
+    MDBX_copy_flags_t flags{MDBX_CP_COMPACT};
+    // 0 - без ограничения
+    std::uint64_t max_bytes_per_sec{};
+    std::uint32_t progress_interval_ms{1000};
+    Napi::Function on_progress{};
+};
+
+copy_options parse_copy_options(const Napi::Value& arg0);
+
+struct copy_progress
+{
+    std::uint64_t bytes_written{};
+    std::uint64_t estimated_bytes{};
+    std::int64_t elapsed_ms{};
+};
+
+// копирование с ограничением скорости записи и отчетом о прогрессе,
+// окружение при этом остается доступным для других операций
+class async_copy_paced
+    : public Napi::AsyncProgressWorker<copy_progress>
+{
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    std::string dest_{};
+    MDBX_copy_flags_t flags_{MDBX_CP_COMPACT};
+    std::uint64_t max_bytes_per_sec_{};
+    std::uint32_t progress_interval_ms_{};
+    Napi::FunctionReference on_progress_{};
+    copy_progress last_{};
+    // исключение из onProgress останавливает копирование
+    std::atomic<bool> cancelled_{false};
+    Napi::Reference<Napi::Value> progress_error_{};
+
+public:
+    async_copy_paced(Napi::Env env, envmou& e,
+        std::string dest, copy_options opt);
+
+    void Execute(const ExecutionProgress& progress) override;
+
+    void OnProgress(const copy_progress* data, std::size_t count) override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+
+private:
+    void report(const copy_progress& p);
+};
+
+} // namespace mdbxmou
@@ -0,0 +1,45 @@
+#include "envmou_del_range.hpp"
+#include "envmou.hpp"
+
+namespace mdbxmou {
+
+void async_del_range::Execute()
+{
+    try {
+        auto txn = start_transaction();
+        const auto txnid = txn.id();
+        deleted_ = delete_range(txn, common_.id,
+            mdbx::is_ordinal(common_.key_mod), options_);
+        txn.commit();
+        bloom_registry::committed(env_, txnid);
+    } catch (const std::exception& e) {
+        SetError(e.what());
+    } catch (...) {
+        SetError("async_del_range::Execute");
+    }
+}
+
+void async_del_range::OnOK()
+{
+    --env_;
+
+    deferred_.Resolve(Napi::Number::New(Env(),
+        static_cast<double>(deleted_)));
+}
+
+void async_del_range::OnError(const Napi::Error& e)
+{
+    --env_;
+
+    deferred_.Reject(e.Value());
+}
+
+txnmou_managed async_del_range::start_transaction()
+{
+    MDBX_txn *ptr;
+    mdbx::error::success_or_throw(::mdbx_txn_begin(
+        env_, nullptr, MDBX_TXN_READWRITE, &ptr));
+    return { ptr };
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "querymou.hpp"
+#include "rangemou.hpp"
+
+namespace mdbxmou {
+
+class envmou;
+
+// env.delRange({ dbi, ...range }) - удаление диапазона в фоновой
+// пишущей транзакции
+class async_del_range
+    : public Napi::AsyncWorker
+{
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    async_common common_{};
+    range_options options_{};
+    // число удаленных ключей, заполняется в Execute
+    std::size_t deleted_{};
+
+public:
+    async_del_range(Napi::Env env, envmou& e,
+        async_common common, range_options options)
+        : Napi::AsyncWorker{env}
+        , deferred_{Napi::Promise::Deferred::New(env)}
+        , env_{e}
+        , common_{common}
+        , options_{std::move(options)}
+    {   }
+
+    void Execute() override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+
+    txnmou_managed start_transaction();
+};
+
+} // namespace mdbxmou
@@ -6,8 +6,7 @@ namespace mdbxmou {
 void async_open::Execute() 
 {
     try {
-        auto e = envmou::create_and_open(arg0_);
-        that_.attach(e, arg0_);
+        that_.attach(env_registry::acquire(arg0_), arg0_);
     } catch (const std::exception& e) {
         SetError(e.what());
     }
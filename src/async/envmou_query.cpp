@@ -1,4 +1,5 @@
 #include "envmou_query.hpp"
+#include "changelog.hpp"
 #include "convmou.hpp"
 #include "envmou.hpp"
 
@@ -9,6 +10,7 @@ void async_query::Execute()
     try {
         // стартуем транзакцию
         auto txn = start_transaction();
+        const auto txnid = txn.id();
         for (auto& req : query_) 
         {
             mdbx::map_handle dbi{req.id};
@@ -17,11 +19,20 @@ void async_query::Execute()
                 do_get(txn, dbi, req);
             } else if (mode.is_del()) {
                 do_del(txn, dbi, req);
+            } else if (mode.is_increment()) {
+                do_increment(txn, dbi, req);
+            } else if (mode.is_compare_swap()) {
+                do_compare_swap(txn, dbi, req);
+            } else if (mode.is_put_dups()) {
+                do_put_dups(txn, dbi, req);
             } else {
                 do_put(txn, dbi, req);
             }
         }
         txn.commit();
+        if (!(txn_mode_.val & txn_mode::ro)) {
+            bloom_registry::committed(env_, txnid);
+        }
     } catch (const std::exception& e) {
         SetError(e.what());
     } catch (...) {
@@ -55,10 +66,21 @@ static Napi::Value write_row(Napi::Env env, const query_line& row)
             }
         }
 
+        if (mode.is_increment()) {
+            js_item.Set("value", conv.convert_counter(env, item.counter));
+        }
+
         // выдадим флаги удаления и успешности
         if (mode.is_del()) {
             js_item.Set("found", Napi::Boolean::New(env, item.found));
         }
+        if (mode.is_compare_swap()) {
+            js_item.Set("swapped", Napi::Boolean::New(env, item.found));
+        }
+        if (mode.is_put_dups()) {
+            js_item.Set("count", Napi::Number::New(env,
+                static_cast<double>(item.dups.size())));
+        }
         js_arr.Set(static_cast<uint32_t>(j), js_item);
     }
     return js_arr;
@@ -110,7 +132,11 @@ void async_query::do_del(txnmou_managed& txn,
     {
         auto key = mdbx::is_ordinal(key_mode) ?
             keymou{q.id_buf} : keymou{q.key_buf};
+        bloom_registry::before_delete(txn, dbi.dbi);
         q.found = txn.erase(dbi, key);
+        if (q.found) {
+            changelog::record(txn, changelog::del, dbi.dbi, &key);
+        }
     }
 }
 
@@ -118,11 +144,19 @@ void async_query::do_get(const txnmou_managed& txn,
     mdbx::map_handle dbi, query_line& arg0)
 {
     auto key_mode = arg0.key_mod;
+    bloom_filter::txn_state bloom_txn{};
+    if (arg0.bloom) {
+        bloom_txn = arg0.bloom->state(txn);
+    }
     for (auto& q : arg0.item) 
     {
         auto key = mdbx::is_ordinal(key_mode) ?
             keymou{q.id_buf} : keymou{q.key_buf};
         mdbx::slice abs;
+        if (arg0.bloom && !arg0.bloom->may_contain(bloom_txn, key)) {
+            q.set(abs);
+            continue;
+        }
         valuemou val{txn.get(dbi, key, abs)};
         q.set(val);
     }
@@ -142,7 +176,58 @@ void async_query::do_put(txnmou_managed& txn,
         valuemou val = is_ordinal(arg0.val_mod) ?
             valuemou{q.val_num} :
             valuemou{q.val_buf};
+        bloom_registry::before_write(txn, dbi.dbi, &key);
         mdbx::error::success_or_throw(txn.put(dbi, key, &val, flags));
+        changelog::record(txn, changelog::put, dbi.dbi, &key, &val);
+    }
+}
+
+void async_query::do_increment(txnmou_managed& txn,
+    mdbx::map_handle dbi, query_line& arg0)
+{
+    mdbxmou::dbi db{};
+    db.attach(dbi.dbi);
+    auto key_mode = arg0.key_mod;
+    for (auto& q : arg0.item)
+    {
+        auto key = mdbx::is_ordinal(key_mode) ?
+            keymou{q.id_buf} : keymou{q.key_buf};
+        q.counter = db.increment(txn, key, q.delta);
+    }
+}
+
+void async_query::do_compare_swap(txnmou_managed& txn,
+    mdbx::map_handle dbi, query_line& arg0)
+{
+    mdbxmou::dbi db{};
+    db.attach(dbi.dbi);
+    auto key_mode = arg0.key_mod;
+    const bool ordinal = is_ordinal(arg0.val_mod);
+    for (auto& q : arg0.item)
+    {
+        auto key = mdbx::is_ordinal(key_mode) ?
+            keymou{q.id_buf} : keymou{q.key_buf};
+        valuemou expected = ordinal ?
+            valuemou{q.expected_num} : valuemou{q.expected_buf};
+        valuemou next = ordinal ?
+            valuemou{q.val_num} : valuemou{q.val_buf};
+        q.found = db.compare_and_swap(txn, key,
+            q.has_expected ? &expected : nullptr,
+            q.has_value ? &next : nullptr);
+    }
+}
+
+void async_query::do_put_dups(txnmou_managed& txn,
+    mdbx::map_handle dbi, query_line& arg0)
+{
+    mdbxmou::dbi db{};
+    db.attach(dbi.dbi);
+    auto key_mode = arg0.key_mod;
+    for (auto& q : arg0.item)
+    {
+        auto key = mdbx::is_ordinal(key_mode) ?
+            keymou{q.id_buf} : keymou{q.key_buf};
+        db.put_dups(txn, key, q.dups.data(), q.dups.size());
     }
 }
 
@@ -48,6 +48,15 @@ class async_query
 
     void do_put(txnmou_managed& txn, 
         mdbx::map_handle dbi, query_line& arg0);   
+
+    void do_increment(txnmou_managed& txn,
+        mdbx::map_handle dbi, query_line& arg0);
+
+    void do_compare_swap(txnmou_managed& txn,
+        mdbx::map_handle dbi, query_line& arg0);
+
+    void do_put_dups(txnmou_managed& txn,
+        mdbx::map_handle dbi, query_line& arg0);
 };
 
 } // namespace mdbxmou
\ No newline at end of file
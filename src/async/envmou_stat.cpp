@@ -0,0 +1,124 @@
+#include "envmou_stat.hpp"
+#include "convmou.hpp"
+#include "dbimou.hpp"
+#include "envmou.hpp"
+
+namespace mdbxmou {
+
+stat_request parse_stat(const Napi::Value& arg0)
+{
+    stat_request rc{};
+    if (arg0.IsUndefined() || arg0.IsNull()) {
+        return rc;
+    }
+    if (!arg0.IsObject()) {
+        throw Napi::TypeError::New(arg0.Env(),
+            "stat: expected { dbis: MDBX_Dbi[] }");
+    }
+
+    auto obj = arg0.As<Napi::Object>();
+    auto dbis = obj.Get("dbis");
+    if (dbis.IsUndefined() || dbis.IsNull()) {
+        return rc;
+    }
+    if (!dbis.IsArray()) {
+        throw Napi::TypeError::New(arg0.Env(),
+            "stat: dbis must be an array of MDBX_Dbi");
+    }
+
+    auto arr = dbis.As<Napi::Array>();
+    rc.reserve(arr.Length());
+    for (uint32_t i = 0; i < arr.Length(); ++i) {
+        auto* dbi = dbimou::unwrap_checked(arg0.Env(), arr.Get(i), "stat");
+        stat_line row{};
+        row.id = dbi->get_id();
+        rc.push_back(row);
+    }
+    return rc;
+}
+
+void async_stat::Execute()
+{
+    try {
+        // одна читающая транзакция на весь запрос
+        auto txn = start_transaction();
+        txn_id_ = ::mdbx_txn_id(txn);
+
+        mdbx::error::success_or_throw(::mdbx_env_stat_ex(
+            env_, txn, &env_stat_, sizeof(env_stat_)));
+        mdbx::error::success_or_throw(::mdbx_env_info_ex(
+            env_, txn, &env_info_, sizeof(env_info_)));
+
+        for (auto& row : query_) {
+            row.stat = dbi::get_stat(txn, row.id);
+            mdbx::error::success_or_throw(::mdbx_dbi_flags_ex(
+                txn, row.id, &row.flags, &row.state));
+        }
+
+        txn.commit();
+    } catch (const std::exception& e) {
+        SetError(e.what());
+    } catch (...) {
+        SetError("async_stat::Execute");
+    }
+}
+
+void async_stat::OnOK()
+{
+    --env_;
+
+    Napi::Env env = Env();
+
+    auto info = Napi::Object::New(env);
+    info.Set("mapSize", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_mapsize)));
+    info.Set("geometryCurrent", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_geo.current)));
+    info.Set("geometryUpper", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_geo.upper)));
+    info.Set("lastPgno", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_last_pgno)));
+    info.Set("recentTxnId", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_recent_txnid)));
+    info.Set("latterReaderTxnId", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_latter_reader_txnid)));
+    info.Set("numReaders", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_numreaders)));
+    info.Set("maxReaders", Napi::Number::New(env,
+        static_cast<double>(env_info_.mi_maxreaders)));
+
+    auto dbis = Napi::Array::New(env, query_.size());
+    for (std::size_t i = 0; i < query_.size(); ++i) {
+        const auto& row = query_[i];
+        auto js_row = convmou::convert_stat(env, row.stat);
+        js_row.Set("flags", Napi::Number::New(env,
+            static_cast<double>(row.flags)));
+        dbis.Set(static_cast<uint32_t>(i), js_row);
+    }
+
+    auto result = Napi::Object::New(env);
+    result.Set("txnId", Napi::Number::New(env,
+        static_cast<double>(txn_id_)));
+    result.Set("env", convmou::convert_stat(env, env_stat_));
+    result.Set("info", info);
+    result.Set("dbis", dbis);
+
+    deferred_.Resolve(result);
+}
+
+void async_stat::OnError(const Napi::Error& e)
+{
+    --env_;
+
+    deferred_.Reject(e.Value());
+}
+
+txnmou_managed async_stat::start_transaction()
+{
+    MDBX_txn *ptr;
+    mdbx::error::success_or_throw(::mdbx_txn_begin(
+        env_, nullptr, MDBX_TXN_RDONLY, &ptr));
+    return { ptr };
+}
+
+} // namespace mdbxmou
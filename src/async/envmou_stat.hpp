@@ -0,0 +1,53 @@
+#pragma once
+
+#include "querymou.hpp"
+
+namespace mdbxmou {
+
+class envmou;
+
+struct stat_line
+{
+    MDBX_dbi id{};
+    MDBX_stat stat{};
+    unsigned flags{};
+    unsigned state{};
+};
+
+using stat_request = std::vector<stat_line>;
+stat_request parse_stat(const Napi::Value& arg0);
+
+class async_stat
+    : public Napi::AsyncWorker
+{
+    Napi::Promise::Deferred deferred_;
+    envmou& env_;
+    // запрошенные dbi, заполняются в Execute
+    stat_request query_{};
+    // суммарная статистика окружения и снимок, в котором она снята
+    MDBX_stat env_stat_{};
+    MDBX_envinfo env_info_{};
+    std::uint64_t txn_id_{};
+
+public:
+    async_stat(Napi::Env env, envmou& e, stat_request query)
+        : Napi::AsyncWorker{env}
+        , deferred_{Napi::Promise::Deferred::New(env)}
+        , env_{e}
+        , query_{std::move(query)}
+    {   }
+
+    void Execute() override;
+
+    void OnOK() override;
+
+    void OnError(const Napi::Error& e) override;
+
+    Napi::Promise GetPromise() const {
+        return deferred_.Promise();
+    }
+
+    txnmou_managed start_transaction();
+};
+
+} // namespace mdbxmou
@@ -0,0 +1,234 @@
+#include "txnmou.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mdbxmou {
+
+// txn.execute(dbis, input, inputLength, output) - пакет операций за один
+// переход JS -> native (кодирует lib/batch.js). Все числа little-endian.
+//
+// Операция во входном буфере:
+//   u8 op | u8 dbi (индекс в dbis) | u32 keyLength | key
+//   put: ... | u32 flags | u32 valueLength | value
+// Ключи и значения - готовые байты (строки в utf8, ordinal - 8 байт).
+//
+// Ответ на операцию в выходном буфере:
+//   u8 status (0 - найден/записан/удален, 1 - нет ключа или ключ уже есть)
+//   get с status 0: ... | u32 valueLength | value
+//
+// Возвращает число выполненных операций. Если ответ get не помещается в
+// output, выполнение останавливается до этой операции (get ничего не
+// меняет), и JS повторяет остаток с новым output.
+namespace {
+
+enum batch_op : std::uint8_t {
+    op_get = 1,
+    op_put = 2,
+    op_del = 3,
+    op_has = 4,
+};
+
+enum batch_status : std::uint8_t {
+    status_ok = 0,
+    status_miss = 1,
+};
+
+class batch_reader final
+{
+    const std::uint8_t* ptr_;
+    const std::uint8_t* end_;
+
+public:
+    batch_reader(const std::uint8_t* ptr, std::size_t size) noexcept
+        : ptr_{ptr}
+        , end_{ptr + size}
+    {   }
+
+    bool empty() const noexcept
+    {
+        return ptr_ == end_;
+    }
+
+    const std::uint8_t* take(std::size_t size)
+    {
+        if (static_cast<std::size_t>(end_ - ptr_) < size) {
+            throw std::out_of_range("truncated input");
+        }
+        auto* rc = ptr_;
+        ptr_ += size;
+        return rc;
+    }
+
+    std::uint8_t u8()
+    {
+        return *take(1);
+    }
+
+    std::uint32_t u32()
+    {
+        auto* p = take(4);
+        return static_cast<std::uint32_t>(p[0]) |
+            (static_cast<std::uint32_t>(p[1]) << 8) |
+            (static_cast<std::uint32_t>(p[2]) << 16) |
+            (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    mdbx::slice bytes()
+    {
+        auto size = u32();
+        return {take(size), size};
+    }
+};
+
+class batch_writer final
+{
+    std::uint8_t* ptr_;
+    std::uint8_t* end_;
+
+public:
+    batch_writer(std::uint8_t* ptr, std::size_t size) noexcept
+        : ptr_{ptr}
+        , end_{ptr + size}
+    {   }
+
+    bool fits(std::size_t size) const noexcept
+    {
+        return static_cast<std::size_t>(end_ - ptr_) >= size;
+    }
+
+    void u8(std::uint8_t v) noexcept
+    {
+        *ptr_++ = v;
+    }
+
+    void bytes(const mdbx::slice& v) noexcept
+    {
+        auto size = static_cast<std::uint32_t>(v.size());
+        for (int i = 0; i < 4; ++i) {
+            *ptr_++ = static_cast<std::uint8_t>(size >> (i * 8));
+        }
+        if (size) {
+            std::memcpy(ptr_, v.data(), size);
+            ptr_ += size;
+        }
+    }
+};
+
+std::uint8_t* typed_array_data(const Napi::Env& env, const Napi::Value& arg0,
+    std::size_t& size, const char* what)
+{
+    if (!arg0.IsTypedArray() ||
+        arg0.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+        throw Napi::TypeError::New(env,
+            std::string("execute: ") + what + " must be a Uint8Array");
+    }
+    auto arr = arg0.As<Napi::Uint8Array>();
+    size = arr.ByteLength();
+    return arr.Data();
+}
+
+} // namespace
+
+Napi::Value txnmou::execute(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+
+    if (!is_active()) {
+        throw Napi::Error::New(env, "txn already completed");
+    }
+    if (info.Length() < 4 || !info[0].IsArray()) {
+        throw Napi::TypeError::New(env,
+            "execute: dbis, input, inputLength and output required");
+    }
+
+    auto dbi_array = info[0].As<Napi::Array>();
+    std::vector<dbimou*> dbis(dbi_array.Length());
+    for (std::uint32_t i = 0; i < dbis.size(); ++i) {
+        dbis[i] = dbimou::unwrap_checked(env, dbi_array.Get(i), "execute");
+    }
+
+    std::size_t input_size{};
+    auto* input = typed_array_data(env, info[1], input_size, "input");
+    auto input_length = info[2].ToNumber().Int64Value();
+    if (input_length < 0 || static_cast<std::uint64_t>(input_length) > input_size) {
+        throw Napi::RangeError::New(env, "execute: inputLength out of range");
+    }
+    std::size_t output_size{};
+    auto* output = typed_array_data(env, info[3], output_size, "output");
+
+    before_write(env);
+    batch_reader in{input, static_cast<std::size_t>(input_length)};
+    batch_writer out{output, output_size};
+    std::uint32_t count{};
+    try {
+        while (!in.empty()) {
+            auto op = in.u8();
+            auto index = in.u8();
+            if (index >= dbis.size()) {
+                throw std::out_of_range("dbi index out of range");
+            }
+            auto& db = *dbis[index];
+            keymou key{in.bytes()};
+
+            switch (op) {
+            case op_get: {
+                auto val = static_cast<dbi&>(db).get(*this, key);
+                if (!out.fits(1 + (val.is_null() ? 0 : 4 + val.size()))) {
+                    return Napi::Number::New(env, count);
+                }
+                if (val.is_null()) {
+                    out.u8(status_miss);
+                } else {
+                    out.u8(status_ok);
+                    out.bytes(val);
+                }
+                break;
+            }
+            case op_has: {
+                if (!out.fits(1)) {
+                    return Napi::Number::New(env, count);
+                }
+                out.u8(static_cast<dbi&>(db).has(*this, key) ?
+                    status_ok : status_miss);
+                break;
+            }
+            case op_put: {
+                put_flag flags{static_cast<int>(in.u32())};
+                valuemou val{in.bytes()};
+                if (flags.val & ~put_flag::query_mask) {
+                    throw std::invalid_argument(
+                        "put flags support only noOverwrite/noDupData/current/append/appendDup");
+                }
+                if (!out.fits(1)) {
+                    return Napi::Number::New(env, count);
+                }
+                out.u8(static_cast<dbi&>(db).try_put(*this, key, val, flags) ?
+                    status_ok : status_miss);
+                break;
+            }
+            case op_del: {
+                if (!out.fits(1)) {
+                    return Napi::Number::New(env, count);
+                }
+                out.u8(static_cast<dbi&>(db).del(*this, key) ?
+                    status_ok : status_miss);
+                break;
+            }
+            default:
+                throw std::invalid_argument("unknown opcode");
+            }
+            ++count;
+        }
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, "execute: op " + std::to_string(count) +
+            ": " + e.what());
+    }
+
+    return Napi::Number::New(env, count);
+}
+
+} // namespace mdbxmou
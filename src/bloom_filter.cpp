@@ -0,0 +1,471 @@
+#include "bloom_filter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+namespace mdbxmou {
+
+namespace {
+
+constexpr std::size_t block_words = 8;
+constexpr std::size_t block_bits = block_words * 64;
+constexpr std::size_t min_capacity = 1024;
+// пробы берутся 9-битными срезами одного 64-битного слова
+constexpr unsigned max_probes = 7;
+
+// 64-битный хэш по словам, как MurmurHash64A; фильтр живет только
+// в памяти процесса, поэтому порядок байт платформы не важен
+std::uint64_t hash_key(const void* data, std::size_t size) noexcept
+{
+    constexpr std::uint64_t m = 0xc6a4a7935bd1e995ull;
+    constexpr int r = 47;
+    std::uint64_t h = 0x9e3779b97f4a7c15ull ^ (size * m);
+
+    auto p = static_cast<const unsigned char*>(data);
+    auto end = p + (size & ~std::size_t{7});
+    for (; p != end; p += 8) {
+        std::uint64_t k;
+        std::memcpy(&k, p, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    switch (size & 7) {
+    case 7: h ^= std::uint64_t{p[6]} << 48; [[fallthrough]];
+    case 6: h ^= std::uint64_t{p[5]} << 40; [[fallthrough]];
+    case 5: h ^= std::uint64_t{p[4]} << 32; [[fallthrough]];
+    case 4: h ^= std::uint64_t{p[3]} << 24; [[fallthrough]];
+    case 3: h ^= std::uint64_t{p[2]} << 16; [[fallthrough]];
+    case 2: h ^= std::uint64_t{p[1]} << 8; [[fallthrough]];
+    case 1:
+        h ^= std::uint64_t{p[0]};
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+std::size_t word_count(std::size_t capacity, unsigned bits_per_key) noexcept
+{
+    auto bits = capacity * bits_per_key;
+    auto blocks = (bits + block_bits - 1) / block_bits;
+    return std::max<std::size_t>(blocks, 1) * block_words;
+}
+
+// старшие 32 бита хэша выбирают блок, перемешанный хэш - биты в нем
+std::uint64_t* block_of(std::vector<std::uint64_t>& words, std::uint64_t h) noexcept
+{
+    auto blocks = words.size() / block_words;
+    auto index = static_cast<std::size_t>(((h >> 32) * blocks) >> 32);
+    return words.data() + index * block_words;
+}
+
+void insert(std::vector<std::uint64_t>& words, std::uint64_t h,
+    unsigned probes) noexcept
+{
+    auto* block = block_of(words, h);
+    auto g = h * 0x9e3779b97f4a7c15ull;
+    for (unsigned i = 0; i < probes; ++i) {
+        auto bit = (g >> (i * 9)) & (block_bits - 1);
+        block[bit >> 6] |= std::uint64_t{1} << (bit & 63);
+    }
+}
+
+bool test(std::vector<std::uint64_t>& words, std::uint64_t h,
+    unsigned probes) noexcept
+{
+    auto* block = block_of(words, h);
+    auto g = h * 0x9e3779b97f4a7c15ull;
+    for (unsigned i = 0; i < probes; ++i) {
+        auto bit = (g >> (i * 9)) & (block_bits - 1);
+        if (!(block[bit >> 6] & (std::uint64_t{1} << (bit & 63)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::mutex registry_mutex{};
+std::map<std::pair<MDBX_env*, MDBX_dbi>, std::shared_ptr<bloom_filter>> registry{};
+// без фильтров запись не трогает мьютекс реестра
+std::atomic<std::size_t> registry_size{};
+
+std::vector<std::shared_ptr<bloom_filter>> filters_of(MDBX_env* env)
+{
+    std::vector<std::shared_ptr<bloom_filter>> rc;
+    std::lock_guard<std::mutex> l(registry_mutex);
+    for (auto it = registry.lower_bound({env, 0});
+         it != registry.end() && it->first.first == env; ++it) {
+        rc.push_back(it->second);
+    }
+    return rc;
+}
+
+} // namespace
+
+bloom_filter::bloom_filter(MDBX_env* env, MDBX_dbi dbi,
+    unsigned bits_per_key) noexcept
+    : env_{env}
+    , dbi_{dbi}
+    , bits_per_key_{bits_per_key ? bits_per_key : default_bits_per_key}
+{
+    auto k = std::lround(bits_per_key_ * 0.69);
+    probes_per_key_ = static_cast<unsigned>(
+        std::clamp<long>(k, 1, static_cast<long>(max_probes)));
+}
+
+bloom_filter::~bloom_filter()
+{
+    stop();
+}
+
+bloom_filter::txn_state bloom_filter::state(const MDBX_txn* txn) const noexcept
+{
+    txn_state rc{};
+    MDBX_stat stat;
+    if (mdbx_dbi_stat(txn, dbi_, &stat, sizeof(stat)) != MDBX_SUCCESS) {
+        return rc;
+    }
+    rc.valid = true;
+    rc.writer = (mdbx_txn_flags(txn) & MDBX_TXN_RDONLY) == 0;
+    rc.txnid = mdbx_txn_id(txn);
+    rc.mod_txnid = stat.ms_mod_txnid;
+    return rc;
+}
+
+bool bloom_filter::may_contain(const txn_state& txn, const mdbx::slice& key)
+{
+    if (!txn.valid) {
+        return true;
+    }
+    auto h = hash_key(key.data(), key.size());
+
+    std::lock_guard<std::mutex> l(mutex_);
+    if (stopped_) {
+        return true;
+    }
+    if (txn.writer && txn.mod_txnid == txn.txnid) {
+        // DBI уже изменен этой транзакцией: ее ключи добавлены до записи,
+        // поэтому фильтр верен, если она начата от покрытого состояния
+        if (!ready_ || pending_txnid_ != txn.mod_txnid ||
+            !pending_valid_ || pending_pre_ < base_ || pending_pre_ > covered_) {
+            return true;
+        }
+    } else if (!ready_ || txn.mod_txnid > covered_) {
+        // построение посреди пишущей транзакции сбросило бы ее покрытие
+        if (!txn.writer) {
+            start_build_locked();
+        }
+        return true;
+    } else if (txn.mod_txnid < base_) {
+        // более старый снимок, чем построенный
+        return true;
+    }
+
+    ++probes_;
+    if (test(words_, h, probes_per_key_)) {
+        return true;
+    }
+    ++negatives_;
+    return false;
+}
+
+void bloom_filter::track_locked(MDBX_txn* txn)
+{
+    auto txnid = mdbx_txn_id(txn);
+    if (pending_txnid_ != txnid) {
+        // первая запись транзакции: DBI еще в зафиксированном состоянии
+        MDBX_stat stat;
+        pending_txnid_ = txnid;
+        pending_valid_ = mdbx_dbi_stat(txn, dbi_, &stat, sizeof(stat)) ==
+            MDBX_SUCCESS;
+        pending_pre_ = pending_valid_ ? stat.ms_mod_txnid : 0;
+    }
+}
+
+void bloom_filter::before_write(MDBX_txn* txn, const mdbx::slice& key)
+{
+    auto h = hash_key(key.data(), key.size());
+
+    std::lock_guard<std::mutex> l(mutex_);
+    if (stopped_) {
+        return;
+    }
+
+    track_locked(txn);
+    if (building_) {
+        journal_.emplace_back(key.char_ptr(), key.size());
+    }
+    if (ready_) {
+        insert(words_, h, probes_per_key_);
+        // переполненный фильтр перестраивается после фиксации
+        ++keys_;
+    }
+}
+
+void bloom_filter::before_delete(MDBX_txn* txn)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!stopped_) {
+        track_locked(txn);
+    }
+}
+
+void bloom_filter::committed(std::uint64_t txnid) noexcept
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    if (pending_txnid_ != txnid) {
+        return;
+    }
+    pending_txnid_ = 0;
+    if (!pending_valid_) {
+        return;
+    }
+
+    if (building_) {
+        try {
+            commits_.emplace_back(pending_pre_, txnid);
+        } catch (...) {
+            // без записи новый фильтр просто не покроет эту фиксацию
+        }
+    }
+    if (ready_ && pending_pre_ >= base_ && pending_pre_ <= covered_) {
+        covered_ = txnid;
+    }
+    if (ready_ && keys_ > capacity_) {
+        start_build_locked();
+    }
+}
+
+void bloom_filter::request_build()
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    start_build_locked();
+}
+
+void bloom_filter::start_build_locked()
+{
+    if (building_ || stopped_) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_build_) {
+        return;
+    }
+
+    // прошлый построитель уже вышел из-под мьютекса
+    if (builder_.joinable()) {
+        builder_.join();
+    }
+
+    journal_.clear();
+    commits_.clear();
+    // ключи текущей транзакции могли не попасть ни в снимок, ни в журнал
+    pending_valid_ = false;
+    building_ = true;
+    try {
+        builder_ = std::thread{&bloom_filter::build, this};
+    } catch (...) {
+        building_ = false;
+        next_build_ = now + rebuild_interval;
+    }
+}
+
+void bloom_filter::build() noexcept
+{
+    std::vector<std::uint64_t> words;
+    std::size_t capacity{};
+    std::size_t keys{};
+    std::uint64_t mod{};
+    bool ok{false};
+
+    try {
+        MDBX_txn* txn{};
+        if (mdbx_txn_begin(env_, nullptr, MDBX_TXN_RDONLY, &txn) == MDBX_SUCCESS) {
+            txnmou_managed guard{txn};
+            MDBX_stat stat;
+            MDBX_cursor* cursor{};
+            if (mdbx_dbi_stat(txn, dbi_, &stat, sizeof(stat)) == MDBX_SUCCESS &&
+                mdbx_cursor_open(txn, dbi_, &cursor) == MDBX_SUCCESS) {
+                cursormou_managed cursor_guard{cursor};
+                mod = stat.ms_mod_txnid;
+                capacity = std::max<std::size_t>(
+                    static_cast<std::size_t>(stat.ms_entries) * 2, min_capacity);
+                words.assign(word_count(capacity, bits_per_key_), 0);
+
+                MDBX_val key, value;
+                auto rc = mdbx_cursor_get(cursor, &key, &value, MDBX_FIRST);
+                while (rc == MDBX_SUCCESS) {
+                    insert(words, hash_key(key.iov_base, key.iov_len),
+                        probes_per_key_);
+                    // закрытие окружения ждет построитель
+                    if ((++keys & 0xfff) == 0 && stopped_) {
+                        break;
+                    }
+                    rc = mdbx_cursor_get(cursor, &key, &value, MDBX_NEXT_NODUP);
+                }
+                ok = (rc == MDBX_NOTFOUND);
+            }
+        }
+    } catch (...) {
+        ok = false;
+    }
+
+    std::lock_guard<std::mutex> l(mutex_);
+    building_ = false;
+    next_build_ = std::chrono::steady_clock::now() + rebuild_interval;
+    if (ok && !stopped_) {
+        for (auto& key : journal_) {
+            insert(words, hash_key(key.data(), key.size()), probes_per_key_);
+        }
+        keys += journal_.size();
+
+        // фиксации биндинга во время построения продолжают покрытие
+        auto covered = mod;
+        for (auto& [pre, txnid] : commits_) {
+            if (pre >= mod && pre <= covered) {
+                covered = txnid;
+            }
+        }
+
+        words_.swap(words);
+        capacity_ = capacity;
+        keys_ = keys;
+        base_ = mod;
+        covered_ = covered;
+        ready_ = true;
+        ++builds_;
+    }
+    journal_.clear();
+    commits_.clear();
+}
+
+void bloom_filter::stop() noexcept
+{
+    std::thread builder;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        stopped_ = true;
+        ready_ = false;
+        builder = std::move(builder_);
+    }
+    if (builder.joinable()) {
+        builder.join();
+    }
+}
+
+bloom_filter::stats bloom_filter::get_stats()
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    stats rc{};
+    rc.ready = ready_;
+    rc.building = building_;
+    rc.bits_per_key = bits_per_key_;
+    rc.capacity = capacity_;
+    rc.keys = keys_;
+    rc.base = base_;
+    rc.covered = covered_;
+    rc.probes = probes_;
+    rc.negatives = negatives_;
+    rc.builds = builds_;
+    return rc;
+}
+
+std::shared_ptr<bloom_filter> bloom_registry::enable(MDBX_env* env,
+    MDBX_dbi dbi, unsigned bits_per_key)
+{
+    std::shared_ptr<bloom_filter> rc;
+    {
+        std::lock_guard<std::mutex> l(registry_mutex);
+        auto& slot = registry[{env, dbi}];
+        if (slot) {
+            return slot;
+        }
+        slot = std::make_shared<bloom_filter>(env, dbi, bits_per_key);
+        registry_size = registry.size();
+        rc = slot;
+    }
+    rc->request_build();
+    return rc;
+}
+
+std::shared_ptr<bloom_filter> bloom_registry::find(MDBX_env* env, MDBX_dbi dbi)
+{
+    if (registry_size == 0) {
+        return {};
+    }
+    std::lock_guard<std::mutex> l(registry_mutex);
+    auto it = registry.find({env, dbi});
+    return (it != registry.end()) ? it->second : nullptr;
+}
+
+void bloom_registry::before_write(MDBX_txn* txn, MDBX_dbi dbi,
+    const MDBX_val* key)
+{
+    if (auto filter = find(mdbx_txn_env(txn), dbi)) {
+        filter->before_write(txn, mdbx::slice{*key});
+    }
+}
+
+void bloom_registry::before_delete(MDBX_txn* txn, MDBX_dbi dbi)
+{
+    if (auto filter = find(mdbx_txn_env(txn), dbi)) {
+        filter->before_delete(txn);
+    }
+}
+
+void bloom_registry::committed(MDBX_env* env, std::uint64_t txnid) noexcept
+{
+    if (registry_size == 0) {
+        return;
+    }
+    try {
+        for (auto& filter : filters_of(env)) {
+            filter->committed(txnid);
+        }
+    } catch (...) {
+        // фильтры без фиксации просто не продлят покрытие
+    }
+}
+
+void bloom_registry::dropped(MDBX_env* env, MDBX_dbi dbi) noexcept
+{
+    std::shared_ptr<bloom_filter> filter;
+    {
+        std::lock_guard<std::mutex> l(registry_mutex);
+        auto it = registry.find({env, dbi});
+        if (it == registry.end()) {
+            return;
+        }
+        filter = std::move(it->second);
+        registry.erase(it);
+        registry_size = registry.size();
+    }
+    filter->stop();
+}
+
+void bloom_registry::forget(MDBX_env* env) noexcept
+{
+    std::vector<std::shared_ptr<bloom_filter>> filters;
+    {
+        std::lock_guard<std::mutex> l(registry_mutex);
+        auto it = registry.lower_bound({env, 0});
+        while (it != registry.end() && it->first.first == env) {
+            filters.push_back(std::move(it->second));
+            it = registry.erase(it);
+        }
+        registry_size = registry.size();
+    }
+    for (auto& filter : filters) {
+        filter->stop();
+    }
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "valuemou.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mdbxmou {
+
+// Блочный фильтр Блума одного DBI (openMap({ bloom })): промах по ключу
+// определяется без спуска по B-дереву. Блок - 512 бит (линия кэша), все
+// пробы ключа попадают в один блок.
+//
+// Фильтр верен для снимков, в которых ms_mod_txnid DBI лежит в
+// [base, covered]. base - снимок фонового построения, covered растет при
+// фиксации пишущих транзакций биндинга, начатых от покрытого состояния.
+// Ключи добавляются до записи, удаления не учитываются - фильтр остается
+// надмножеством. После записи другим процессом mod_txnid выходит за
+// covered: фильтр не используется, пока фон не построит его заново.
+// Внутри пишущей транзакции биндинга, уже изменившей DBI, фильтр верен,
+// если она начата от покрытого состояния; построение из пишущей
+// транзакции не запускается.
+class bloom_filter final
+{
+public:
+    static constexpr unsigned default_bits_per_key = 10;
+    // перестроение после промаха по снимку - не чаще
+    static constexpr std::chrono::milliseconds rebuild_interval{1000};
+
+    struct stats
+    {
+        bool ready{};
+        bool building{};
+        unsigned bits_per_key{};
+        std::size_t capacity{};
+        std::size_t keys{};
+        std::uint64_t base{};
+        std::uint64_t covered{};
+        std::uint64_t probes{};
+        std::uint64_t negatives{};
+        std::uint64_t builds{};
+    };
+
+    bloom_filter(MDBX_env* env, MDBX_dbi dbi, unsigned bits_per_key) noexcept;
+    ~bloom_filter();
+
+    bloom_filter(const bloom_filter&) = delete;
+    bloom_filter& operator=(const bloom_filter&) = delete;
+
+    // состояние DBI в транзакции для серии проб: mdbx_dbi_stat читается
+    // один раз, пока транзакция не пишет в DBI
+    struct txn_state
+    {
+        bool valid{};
+        bool writer{};
+        std::uint64_t txnid{};
+        std::uint64_t mod_txnid{};
+    };
+
+    txn_state state(const MDBX_txn* txn) const noexcept;
+
+    // false - ключа точно нет в снимке txn; true - может быть, в том числе
+    // когда фильтр еще строится или снимок им не покрыт
+    bool may_contain(const MDBX_txn* txn, const mdbx::slice& key)
+    {
+        return may_contain(state(txn), key);
+    }
+
+    bool may_contain(const txn_state& txn, const mdbx::slice& key);
+
+    // вызывается биндингом до записи key в пишущей транзакции txn
+    void before_write(MDBX_txn* txn, const mdbx::slice& key);
+
+    // до удаления: ключей не добавляет, но фиксация txn продлит покрытие
+    void before_delete(MDBX_txn* txn);
+
+    // пишущая транзакция txnid биндинга успешно зафиксирована
+    void committed(std::uint64_t txnid) noexcept;
+
+    // запустить построение, если его нет
+    void request_build();
+
+    // остановить фоновое построение, фильтр больше не используется
+    void stop() noexcept;
+
+    stats get_stats();
+
+private:
+    void track_locked(MDBX_txn* txn);
+    void start_build_locked();
+    void build() noexcept;
+
+    MDBX_env* env_{};
+    MDBX_dbi dbi_{};
+    unsigned bits_per_key_{default_bits_per_key};
+    unsigned probes_per_key_{};
+
+    std::mutex mutex_{};
+    std::vector<std::uint64_t> words_{};
+    std::size_t capacity_{};
+    std::size_t keys_{};
+    std::uint64_t base_{};
+    std::uint64_t covered_{};
+    bool ready_{false};
+    // читается построителем без мьютекса
+    std::atomic<bool> stopped_{false};
+
+    // пишущая транзакция биндинга и состояние DBI до нее;
+    // pending_valid_ сбрасывается, если построение началось посреди нее
+    std::uint64_t pending_txnid_{};
+    std::uint64_t pending_pre_{};
+    bool pending_valid_{false};
+
+    // изменения за время построения, применяются к новому фильтру
+    bool building_{false};
+    std::vector<std::string> journal_{};
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> commits_{};
+    std::chrono::steady_clock::time_point next_build_{};
+    std::thread builder_{};
+
+    std::uint64_t probes_{};
+    std::uint64_t negatives_{};
+    std::uint64_t builds_{};
+};
+
+// Фильтры процесса по окружению и DBI. Запись через биндинг находит фильтр
+// здесь, даже если ее DBI открыт без bloom, иначе фильтр пропустил бы ключ.
+class bloom_registry final
+{
+public:
+    static std::shared_ptr<bloom_filter> enable(MDBX_env* env, MDBX_dbi dbi,
+        unsigned bits_per_key);
+
+    static std::shared_ptr<bloom_filter> find(MDBX_env* env, MDBX_dbi dbi);
+
+    static void before_write(MDBX_txn* txn, MDBX_dbi dbi, const MDBX_val* key);
+
+    static void before_delete(MDBX_txn* txn, MDBX_dbi dbi);
+
+    // после успешной фиксации пишущей транзакции
+    static void committed(MDBX_env* env, std::uint64_t txnid) noexcept;
+
+    // DBI удален, его номер может достаться другой таблице
+    static void dropped(MDBX_env* env, MDBX_dbi dbi) noexcept;
+
+    // окружение закрывается: остановить построение
+    static void forget(MDBX_env* env) noexcept;
+};
+
+} // namespace mdbxmou
@@ -0,0 +1,184 @@
+#include "changelog.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace mdbxmou {
+
+namespace {
+
+void store_be(char* out, std::uint64_t value, std::size_t size) noexcept
+{
+    for (std::size_t i = size; i > 0; --i) {
+        out[i - 1] = static_cast<char>(value & 0xff);
+        value >>= 8;
+    }
+}
+
+std::uint64_t load_be(const char* in, std::size_t size) noexcept
+{
+    std::uint64_t value{};
+    for (std::size_t i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<unsigned char>(in[i]);
+    }
+    return value;
+}
+
+} // namespace
+
+MDBX_dbi changelog::open(MDBX_env* env, bool create)
+{
+    MDBX_txn* txn;
+    auto rc = mdbx_txn_begin(env, nullptr,
+        create ? MDBX_TXN_READWRITE : MDBX_TXN_RDONLY, &txn);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    txnmou_managed guard{txn};
+
+    MDBX_dbi dbi{};
+    rc = mdbx_dbi_open(txn, map_name,
+        create ? MDBX_CREATE : MDBX_DB_DEFAULTS, &dbi);
+    if (rc == MDBX_NOTFOUND && !create) {
+        return 0;
+    }
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+
+    guard.commit();
+    return dbi;
+}
+
+const env_arg0* changelog::config(MDBX_txn* txn, MDBX_dbi dbi) noexcept
+{
+    auto* conf = static_cast<const env_arg0*>(
+        mdbx_env_get_userctx(mdbx_txn_env(txn)));
+    if (!conf || (conf->changelog == off) || !conf->changelog_dbi ||
+        (dbi == conf->changelog_dbi)) {
+        return nullptr;
+    }
+    return conf;
+}
+
+bool changelog::active(MDBX_txn* txn, MDBX_dbi dbi) noexcept
+{
+    return config(txn, dbi) != nullptr;
+}
+
+bool changelog::records_values(MDBX_txn* txn, MDBX_dbi dbi) noexcept
+{
+    auto* conf = config(txn, dbi);
+    return conf && (conf->changelog == values);
+}
+
+void changelog::record(MDBX_txn* txn, op kind, MDBX_dbi dbi,
+    const MDBX_val* key, const MDBX_val* value)
+{
+    if (auto* conf = config(txn, dbi)) {
+        append(txn, *conf, kind, dbi, key, value);
+    }
+}
+
+void changelog::encode_key(std::uint64_t txnid, std::uint64_t seq,
+    char* out) noexcept
+{
+    store_be(out, txnid, 8);
+    store_be(out + 8, seq, 8);
+}
+
+void changelog::append(MDBX_txn* txn, const env_arg0& conf, op kind,
+    MDBX_dbi dbi, const MDBX_val* key, const MDBX_val* value)
+{
+    // номер операции внутри транзакции: пишущая транзакция в окружении
+    // одна, поэтому счетчик держим в userctx и ищем последнюю запись
+    // журнала только на первой операции транзакции. txnid отмененной
+    // транзакции достается следующей - тогда seq продолжается с пропуском,
+    // порядок ключей от этого не меняется
+    auto txnid = mdbx_txn_id(txn);
+    if (conf.changelog_txnid != txnid) {
+        conf.changelog_txnid = txnid;
+        conf.changelog_seq = next_seq(txn, conf.changelog_dbi, txnid);
+    }
+    auto seq = conf.changelog_seq;
+
+    std::size_t key_len = key ? key->iov_len : 0;
+    bool with_value = value && (conf.changelog == values);
+    std::size_t val_len = with_value ? value->iov_len : 0;
+
+    char key_buf[key_size];
+    encode_key(txnid, seq, key_buf);
+    MDBX_val log_key{key_buf, key_size};
+    MDBX_val log_val{nullptr, header_size + key_len + val_len};
+    auto rc = mdbx_put(txn, conf.changelog_dbi, &log_key, &log_val,
+        static_cast<MDBX_put_flags_t>(MDBX_APPEND | MDBX_RESERVE));
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    conf.changelog_seq = seq + 1;
+
+    auto out = static_cast<char*>(log_val.iov_base);
+    out[0] = static_cast<char>(kind | (with_value ? value_bit : 0));
+    store_be(out + 1, dbi, 4);
+    store_be(out + 5, key_len, 4);
+    if (key_len) {
+        std::memcpy(out + header_size, key->iov_base, key_len);
+    }
+    if (val_len) {
+        std::memcpy(out + header_size + key_len, value->iov_base, val_len);
+    }
+}
+
+std::uint64_t changelog::next_seq(MDBX_txn* txn, MDBX_dbi log_dbi,
+    std::uint64_t txnid)
+{
+    MDBX_cursor* ptr;
+    auto rc = mdbx_cursor_open(txn, log_dbi, &ptr);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    cursormou_managed cursor{ptr};
+
+    MDBX_val last_key{};
+    MDBX_val last_val{};
+    rc = mdbx_cursor_get(ptr, &last_key, &last_val, MDBX_LAST);
+    if (rc == MDBX_NOTFOUND) {
+        return 0;
+    }
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    if (last_key.iov_len == key_size) {
+        auto last = static_cast<const char*>(last_key.iov_base);
+        if (load_be(last, 8) == txnid) {
+            return load_be(last + 8, 8) + 1;
+        }
+    }
+    return 0;
+}
+
+changelog::entry changelog::decode(const MDBX_val& key, const MDBX_val& data)
+{
+    if ((key.iov_len != key_size) || (data.iov_len < header_size)) {
+        throw std::runtime_error("changelog: malformed entry");
+    }
+
+    auto k = static_cast<const char*>(key.iov_base);
+    auto d = static_cast<const char*>(data.iov_base);
+    entry rc{};
+    rc.txnid = load_be(k, 8);
+    rc.seq = load_be(k + 8, 8);
+    auto tag = static_cast<std::uint8_t>(d[0]);
+    rc.kind = static_cast<op>(tag & ~value_bit);
+    rc.has_value = (tag & value_bit) != 0;
+    rc.dbi = static_cast<MDBX_dbi>(load_be(d + 1, 4));
+    auto key_len = static_cast<std::size_t>(load_be(d + 5, 4));
+    if (header_size + key_len > data.iov_len) {
+        throw std::runtime_error("changelog: malformed entry");
+    }
+    rc.key = mdbx::slice{d + header_size, key_len};
+    auto rest = data.iov_len - header_size - key_len;
+    rc.value = mdbx::slice{d + header_size + key_len, rest};
+    return rc;
+}
+
+} // namespace mdbxmou
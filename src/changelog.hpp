@@ -0,0 +1,78 @@
+#pragma once
+
+#include "env_arg0.hpp"
+#include <cstdint>
+
+namespace mdbxmou {
+
+// Журнал изменений (change data capture): отдельный DBI, в который
+// биндинг дописывает каждую запись в той же пишущей транзакции.
+//
+// ключ: txnid (8 байт BE) | seq (8 байт BE) - порядок memcmp совпадает
+//       с порядком фиксации транзакций и операций внутри нее
+// значение: op (1) | dbi (4 BE) | длина ключа (4 BE) | ключ | [значение],
+//       старший бит op отмечает записанное значение
+class changelog
+{
+public:
+    enum op : std::uint8_t {
+        put = 1,
+        del = 2,
+        // очистка DBI (drop без удаления)
+        clear = 3,
+        // удаление DBI
+        drop = 4,
+    };
+
+    enum mode : std::uint8_t {
+        off = 0,
+        keys = 1,
+        values = 2,
+    };
+
+    static constexpr const char* map_name = "__mdbxmou_changelog";
+    static constexpr std::size_t key_size = 16;
+    static constexpr std::size_t header_size = 9;
+    static constexpr std::uint8_t value_bit = 0x80;
+
+    struct entry {
+        std::uint64_t txnid{};
+        std::uint64_t seq{};
+        op kind{put};
+        MDBX_dbi dbi{};
+        mdbx::slice key{};
+        mdbx::slice value{};
+        bool has_value{false};
+    };
+
+    // открыть DBI журнала, create - создать если его нет;
+    // 0 если журнала в базе нет
+    static MDBX_dbi open(MDBX_env* env, bool create);
+
+    // включен ли журнал для записей в dbi этой транзакции
+    static bool active(MDBX_txn* txn, MDBX_dbi dbi) noexcept;
+
+    // журнал dbi пишет значения (changelog: { values: true })
+    static bool records_values(MDBX_txn* txn, MDBX_dbi dbi) noexcept;
+
+    // дописать операцию над dbi, если журнал включен
+    static void record(MDBX_txn* txn, op kind, MDBX_dbi dbi,
+        const MDBX_val* key, const MDBX_val* value = nullptr);
+
+    static void encode_key(std::uint64_t txnid, std::uint64_t seq,
+        char* out) noexcept;
+
+    static entry decode(const MDBX_val& key, const MDBX_val& data);
+
+private:
+    static const env_arg0* config(MDBX_txn* txn, MDBX_dbi dbi) noexcept;
+
+    static void append(MDBX_txn* txn, const env_arg0& conf, op kind,
+        MDBX_dbi dbi, const MDBX_val* key, const MDBX_val* value);
+
+    // seq первой операции транзакции txnid по последней записи журнала
+    static std::uint64_t next_seq(MDBX_txn* txn, MDBX_dbi log_dbi,
+        std::uint64_t txnid);
+};
+
+} // namespace mdbxmou
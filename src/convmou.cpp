@@ -1,5 +1,7 @@
 #include "convmou.hpp"
 #include "dbimou.hpp"
+#include "objmou.hpp"
+#include "tuplemou.hpp"
 
 namespace mdbxmou {
 
@@ -16,9 +18,11 @@ convmou convmou::for_dbi(const dbimou& dbi) noexcept
 Napi::Value convmou::convert_key(const Napi::Env& env, const keymou& key) const
 {
     if (mdbx::is_ordinal(key_mode_)) {
-        return (key_flag_ & base_flag::bigint) ?
-            key.to_bigint(env) :
-            key.to_number(env);
+        return key.to_ordinal(env, key_mode_, key_flag_ & base_flag::bigint);
+    }
+
+    if (key_flag_ & base_flag::tuple) {
+        return tuplemou::decode(env, key);
     }
 
     return (key_flag_ & base_flag::string) ?
@@ -34,11 +38,24 @@ Napi::Value convmou::convert_value(const Napi::Env& env, const valuemou& val) co
             val.to_number(env);
     }
 
+    if (value_flag_ & base_flag::object) {
+        return objmou::decode(env, val);
+    }
+
     return (value_flag_ & base_flag::string) ?
         val.to_string(env) :
         val.to_buffer(env);
 }
 
+Napi::Value convmou::convert_counter(const Napi::Env& env,
+    std::int64_t counter) const
+{
+    if (value_flag_ & base_flag::bigint) {
+        return Napi::BigInt::New(env, counter);
+    }
+    return Napi::Number::New(env, static_cast<double>(counter));
+}
+
 Napi::Object convmou::make_result(const Napi::Env& env,
     const keymou& key, const valuemou& val) const
 {
@@ -48,4 +65,23 @@ Napi::Object convmou::make_result(const Napi::Env& env,
     return result;
 }
 
+Napi::Object convmou::convert_stat(const Napi::Env& env,
+    const MDBX_stat& stat)
+{
+    auto result = Napi::Object::New(env);
+    result.Set("pageSize", Napi::Number::New(env, stat.ms_psize));
+    result.Set("depth", Napi::Number::New(env, stat.ms_depth));
+    result.Set("branchPages", Napi::Number::New(env,
+        static_cast<double>(stat.ms_branch_pages)));
+    result.Set("leafPages", Napi::Number::New(env,
+        static_cast<double>(stat.ms_leaf_pages)));
+    result.Set("overflowPages", Napi::Number::New(env,
+        static_cast<double>(stat.ms_overflow_pages)));
+    result.Set("entries", Napi::Number::New(env,
+        static_cast<double>(stat.ms_entries)));
+    result.Set("modTxnId", Napi::Number::New(env,
+        static_cast<double>(stat.ms_mod_txnid)));
+    return result;
+}
+
 } // namespace mdbxmou
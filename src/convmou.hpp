@@ -19,8 +19,14 @@ struct convmou
 
     Napi::Value convert_value(const Napi::Env& env, const valuemou& val) const;
 
+    // значение increment(): BigInt для valueFlag.bigint, иначе Number
+    Napi::Value convert_counter(const Napi::Env& env, std::int64_t counter) const;
+
     Napi::Object make_result(const Napi::Env& env,
         const keymou& key, const valuemou& val) const;
+
+    static Napi::Object convert_stat(const Napi::Env& env,
+        const MDBX_stat& stat);
 };
 
 } // namespace mdbxmou
@@ -1,5 +1,7 @@
 #include "cursormou.hpp"
+#include "changelog.hpp"
 #include "dbimou.hpp"
+#include "objmou.hpp"
 #include "txnmou.hpp"
 #include <cassert>
 
@@ -20,6 +22,7 @@ Napi::Function cursormou::init(const char* class_name, Napi::Env env)
 			InstanceMethod("seek", &cursormou::seek),
 			InstanceMethod("seekGE", &cursormou::seek_ge),
 			InstanceMethod("current", &cursormou::current),
+			InstanceMethod("getDups", &cursormou::get_dups),
 			InstanceMethod("eof", &cursormou::eof),
 			InstanceMethod("onFirst", &cursormou::on_first),
 			InstanceMethod("onLast", &cursormou::on_last),
@@ -28,6 +31,8 @@ Napi::Function cursormou::init(const char* class_name, Napi::Env env)
 			InstanceMethod("put", &cursormou::put),
 			InstanceMethod("del", &cursormou::del),
 			InstanceMethod("forEach", &cursormou::for_each),
+			InstanceMethod("renew", &cursormou::renew),
+			InstanceMethod("unbind", &cursormou::unbind),
 			InstanceMethod("close", &cursormou::close),
 		});
 
@@ -54,6 +59,13 @@ txnmou* cursormou::get_transaction(napi_env env) const noexcept
 	return static_cast<txnmou*>(txn);
 }
 
+void cursormou::mark_used() noexcept
+{
+	if (txn_) {
+		txn_->mark_used();
+	}
+}
+
 void cursormou::close_native(txnmou* txn) noexcept
 {
 	if (!cursor_) {
@@ -70,6 +82,7 @@ void cursormou::close_native(txnmou* txn) noexcept
 
 void cursormou::release_references() noexcept
 {
+	txn_ = nullptr;
 	Napi::ObjectReference txn_ref{std::move(txn_ref_)};
 	Napi::ObjectReference dbi_ref{std::move(dbi_ref_)};
 }
@@ -103,6 +116,7 @@ void cursormou::attach(const Napi::Object& txn_object,
 	txn_ref_ = std::move(txn_ref);
 	dbi_ref_ = std::move(dbi_ref);
 	++(*txn);
+	txn_ = txn;
 	dbi_ = dbi;
 	cursor_ = cursor;
 }
@@ -113,6 +127,7 @@ Napi::Value cursormou::move(const Napi::Env& env, MDBX_cursor_op op)
 	if (!cursor_) {
 		throw Napi::Error::New(env, "cursor closed");
 	}
+	mark_used();
 
 	keymou key{};
 	valuemou val{};
@@ -153,6 +168,33 @@ Napi::Value cursormou::current(const Napi::CallbackInfo& info)
 	return move(info.Env(), MDBX_GET_CURRENT);
 }
 
+Napi::Value cursormou::get_dups(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+	if (!cursor_) {
+		throw Napi::Error::New(env, "cursor closed");
+	}
+
+	mark_used();
+
+	// с ключом - MDBX_SET_KEY, без него - текущий ключ с первого значения;
+	// курсор остается на последнем значении ключа
+	try {
+		if (info.Length() > 0 && !info[0].IsUndefined()) {
+			auto key = dbi_->make_key(env, info[0], key_buf_, key_num_);
+			return dbi_->read_dups(env, cursor_, MDBX_SET_KEY, &key);
+		}
+		if (::mdbx_cursor_eof(cursor_) == MDBX_RESULT_TRUE) {
+			return env.Undefined();
+		}
+		return dbi_->read_dups(env, cursor_, MDBX_FIRST_DUP, nullptr);
+	} catch (const Napi::Error&) {
+		throw;
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, std::string("getDups: ") + e.what());
+	}
+}
+
 Napi::Value cursormou::eof(const Napi::CallbackInfo& info)
 {
 	Napi::Env env = info.Env();
@@ -226,12 +268,16 @@ Napi::Value cursormou::seek_impl(
 	if (info.Length() < 1) {
 		throw Napi::Error::New(env, "key required");
 	}
+	mark_used();
 
-	auto key_mode = dbi_->get_key_mode();
-
-	keymou key = (mdbx::is_ordinal(key_mode))
-		? keymou::from(info[0], env, key_num_)
-		: keymou::from(info[0], env, key_buf_);
+	keymou key{};
+	try {
+		key = dbi_->make_key(env, info[0], key_buf_, key_num_);
+	} catch (const Napi::Error&) {
+		throw;
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, e.what());
+	}
 
 	valuemou val{};
 	auto rc = mdbx_cursor_get(cursor_, key, val, op);
@@ -267,15 +313,25 @@ Napi::Value cursormou::put(const Napi::CallbackInfo& info)
 	if (info.Length() < 2) {
 		throw Napi::Error::New(env, "key and value required");
 	}
+	mark_used();
 
-	auto key_mode = dbi_->get_key_mode();
-
-	keymou key = (mdbx::is_ordinal(key_mode))
-		? keymou::from(info[0], env, key_num_)
-		: keymou::from(info[0], env, key_buf_);
+	if (auto* txn = get_transaction(env)) {
+		txn->before_write(env);
+	}
 
-	valuemou val = valuemou::from(
-		info[1], env, val_buf_, val_num_, is_ordinal(dbi_->get_value_mode()));
+	keymou key{};
+	valuemou val{};
+	try {
+		key = dbi_->make_key(env, info[0], key_buf_, key_num_);
+		val = (dbi_->get_value_flag() & base_flag::object)
+			? objmou::encode(info[1], val_buf_)
+			: valuemou::from(info[1], env, val_buf_, val_num_,
+				is_ordinal(dbi_->get_value_mode()));
+	} catch (const Napi::Error&) {
+		throw;
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, e.what());
+	}
 
 	// Опциональный флаг put_mode (по умолчанию MDBX_UPSERT)
 	MDBX_put_flags_t flags = MDBX_UPSERT;
@@ -284,11 +340,25 @@ Napi::Value cursormou::put(const Napi::CallbackInfo& info)
 			info[2].As<Napi::Number>().Int32Value());
 	}
 
+	try {
+		bloom_registry::before_write(mdbx_cursor_txn(cursor_),
+			mdbx_cursor_dbi(cursor_), &key);
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, e.what());
+	}
+
 	auto rc = mdbx_cursor_put(cursor_, key, val, flags);
 	if (MDBX_SUCCESS != rc) {
 		throw Napi::Error::New(env, mdbx_strerror(rc));
 	}
 
+	try {
+		changelog::record(mdbx_cursor_txn(cursor_), changelog::put,
+			mdbx_cursor_dbi(cursor_), &key, &val);
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, e.what());
+	}
+
 	return env.Undefined();
 }
 
@@ -307,6 +377,46 @@ Napi::Value cursormou::del(const Napi::CallbackInfo& info)
 			info[0].As<Napi::Number>().Int32Value());
 	}
 
+	mark_used();
+	if (auto* owner = get_transaction(env)) {
+		owner->before_write(env);
+	}
+
+	// журналу нужны ключ (и значение для multi) до удаления записи
+	auto* txn = mdbx_cursor_txn(cursor_);
+	auto dbi = mdbx_cursor_dbi(cursor_);
+	try {
+		bloom_registry::before_delete(txn, dbi);
+	} catch (const std::exception& e) {
+		throw Napi::Error::New(env, e.what());
+	}
+	bool logged = changelog::active(txn, dbi);
+	bool with_value{false};
+	if (logged) {
+		MDBX_val cur_key{};
+		MDBX_val cur_val{};
+		auto rc = mdbx_cursor_get(cursor_, &cur_key, &cur_val, MDBX_GET_CURRENT);
+		if (MDBX_NOTFOUND == rc || MDBX_ENODATA == rc) {
+			return Napi::Boolean::New(env, false);
+		}
+		if (MDBX_SUCCESS != rc) {
+			throw Napi::Error::New(env, mdbx_strerror(rc));
+		}
+		unsigned db_flags{};
+		unsigned db_state{};
+		rc = mdbx_dbi_flags_ex(txn, dbi, &db_flags, &db_state);
+		if (MDBX_SUCCESS != rc) {
+			throw Napi::Error::New(env, mdbx_strerror(rc));
+		}
+		with_value = (db_flags & MDBX_DUPSORT) && !(flags & MDBX_ALLDUPS);
+		auto k = static_cast<const char*>(cur_key.iov_base);
+		key_buf_.assign(k, k + cur_key.iov_len);
+		if (with_value) {
+			auto v = static_cast<const char*>(cur_val.iov_base);
+			val_buf_.assign(v, v + cur_val.iov_len);
+		}
+	}
+
 	auto rc = mdbx_cursor_del(cursor_, flags);
 	if (MDBX_NOTFOUND == rc) {
 		return Napi::Boolean::New(env, false);
@@ -316,6 +426,17 @@ Napi::Value cursormou::del(const Napi::CallbackInfo& info)
 		throw Napi::Error::New(env, mdbx_strerror(rc));
 	}
 
+	if (logged) {
+		try {
+			keymou key{key_buf_};
+			valuemou val{val_buf_};
+			changelog::record(txn, changelog::del, dbi, &key,
+				with_value ? &val : nullptr);
+		} catch (const std::exception& e) {
+			throw Napi::Error::New(env, e.what());
+		}
+	}
+
 	return Napi::Boolean::New(env, true);
 }
 
@@ -333,6 +454,7 @@ Napi::Value cursormou::for_each(const Napi::CallbackInfo& info)
 		throw Napi::TypeError::New(env, "forEach: callback function required");
 	}
 
+	mark_used();
 	auto callback = info[0].As<Napi::Function>();
 	bool backward = info.Length() > 1 && info[1].ToBoolean().Value();
 
@@ -366,11 +488,71 @@ Napi::Value cursormou::for_each(const Napi::CallbackInfo& info)
 	return env.Undefined();
 }
 
+Napi::Value cursormou::renew(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+
+	if (!cursor_) {
+		throw Napi::Error::New(env, "cursor closed");
+	}
+
+	if (info.Length() < 1) {
+		throw Napi::Error::New(env, "renew: txn required");
+	}
+
+	auto* txn = txnmou::unwrap_checked(env, info[0], "renew");
+	if (!txn->is_active()) {
+		throw Napi::Error::New(env, "renew: txn not active");
+	}
+
+	// mdbx_cursor_bind, в отличие от mdbx_cursor_renew, принимает и курсор
+	// после mdbx_cursor_unbind
+	auto rc = mdbx_cursor_bind(*txn, cursor_, dbi_->get_id());
+	if (rc != MDBX_SUCCESS) {
+		throw Napi::Error::New(env, std::string("renew: ") + mdbx_strerror(rc));
+	}
+
+	// курсор больше не держит прежнюю транзакцию открытой
+	if (auto* prev = get_transaction(env)) {
+		--(*prev);
+	}
+	txn_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+	++(*txn);
+	txn_ = txn;
+	return env.Undefined();
+}
+
+Napi::Value cursormou::unbind(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+
+	if (!cursor_) {
+		throw Napi::Error::New(env, "cursor closed");
+	}
+
+	if (txn_ref_.IsEmpty()) {
+		return env.Undefined();
+	}
+
+	auto rc = mdbx_cursor_unbind(cursor_);
+	if (rc != MDBX_SUCCESS) {
+		throw Napi::Error::New(env, std::string("unbind: ") + mdbx_strerror(rc));
+	}
+
+	if (auto* txn = get_transaction(env)) {
+		--(*txn);
+	}
+	txn_ = nullptr;
+	Napi::ObjectReference txn_ref{std::move(txn_ref_)};
+	return env.Undefined();
+}
+
 Napi::Value cursormou::close(const Napi::CallbackInfo& info)
 {
 	auto env = info.Env();
 	auto* txn = get_transaction(env);
-	if (cursor_ && !txn) {
+	// после unbind() курсор не привязан ни к одной транзакции
+	if (cursor_ && !txn_ref_.IsEmpty() && !txn) {
 		throw Napi::Error::New(env, "cursor transaction owner unavailable");
 	}
 
@@ -13,6 +13,8 @@ class cursormou final : public Napi::ObjectWrap<cursormou>
 private:
 	dbimou* dbi_{nullptr};
 	MDBX_cursor* cursor_{nullptr};
+	// транзакция под txn_ref_: навигация отмечает ее для автопарковки
+	txnmou* txn_{nullptr};
 	Napi::ObjectReference txn_ref_{};
 	Napi::ObjectReference dbi_ref_{};
 
@@ -29,6 +31,7 @@ private:
 	Napi::Value seek_impl(const Napi::CallbackInfo& info, MDBX_cursor_op op);
 
 	txnmou* get_transaction(napi_env env) const noexcept;
+	void mark_used() noexcept;
 	void close_native(txnmou* txn) noexcept;
 	void release_references() noexcept;
 
@@ -57,6 +60,9 @@ public:
 	// Текущая позиция
 	Napi::Value current(const Napi::CallbackInfo&);
 
+	// Все значения текущего (или заданного) ключа страницами
+	Napi::Value get_dups(const Napi::CallbackInfo&);
+
 	// Статус курсора
 	Napi::Value eof(const Napi::CallbackInfo&);
 	Napi::Value on_first(const Napi::CallbackInfo&);
@@ -71,6 +77,10 @@ public:
 	// Итерация
 	Napi::Value for_each(const Napi::CallbackInfo&);
 
+	// Перенос в другую транзакцию без нового курсора
+	Napi::Value renew(const Napi::CallbackInfo&);
+	Napi::Value unbind(const Napi::CallbackInfo&);
+
 	// Закрытие
 	Napi::Value close(const Napi::CallbackInfo&);
 
@@ -1,7 +1,25 @@
 #include "dbi.hpp"
+#include "changelog.hpp"
+#include <cstring>
+#include <limits>
 
 namespace mdbxmou {
 
+namespace {
+
+bool is_multi(MDBX_txn* txn, MDBX_dbi dbi)
+{
+    unsigned flags{};
+    unsigned state{};
+    auto rc = mdbx_dbi_flags_ex(txn, dbi, &flags, &state);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    return (flags & MDBX_DUPSORT) != 0;
+}
+
+} // namespace
+
 MDBX_stat dbi::get_stat(const MDBX_txn* txn, MDBX_dbi dbi)
 {
     MDBX_stat stat;
@@ -14,6 +32,9 @@ MDBX_stat dbi::get_stat(const MDBX_txn* txn, MDBX_dbi dbi)
 
 valuemou dbi::get(const MDBX_txn* txn, const keymou& key) const
 {
+    if (bloom_ && !bloom_->may_contain(txn, key)) {
+        return {};
+    }
     valuemou val{};
     auto rc = mdbx_get(txn, id_, key, val);
     if (rc == MDBX_NOTFOUND)
@@ -26,14 +47,28 @@ valuemou dbi::get(const MDBX_txn* txn, const keymou& key) const
 
 void dbi::put(MDBX_txn* txn, const keymou& key, valuemou& value, MDBX_put_flags_t flags)
 {
+    if (!try_put(txn, key, value, flags)) {
+        throw std::runtime_error(mdbx_strerror(MDBX_KEYEXIST));
+    }
+}
+
+bool dbi::try_put(MDBX_txn* txn, const keymou& key, valuemou& value, MDBX_put_flags_t flags)
+{
+    bloom_registry::before_write(txn, id_, &key);
     auto rc = mdbx_put(txn, id_, key, value, flags);
+    if (rc == MDBX_KEYEXIST) {
+        return false;
+    }
     if (rc != MDBX_SUCCESS) {
         throw std::runtime_error(mdbx_strerror(rc));
     }
+    changelog::record(txn, changelog::put, id_, &key, &value);
+    return true;
 }
 
 bool dbi::del(MDBX_txn* txn, const keymou& key)
 {
+    bloom_registry::before_delete(txn, id_);
     auto rc = mdbx_del(txn, id_, key, nullptr);
     if (rc == MDBX_NOTFOUND) {
         return false;
@@ -41,9 +76,139 @@ bool dbi::del(MDBX_txn* txn, const keymou& key)
     if (rc != MDBX_SUCCESS) {
         throw std::runtime_error(mdbx_strerror(rc));
     }
+    changelog::record(txn, changelog::del, id_, &key);
     return true;
 }
 
+void dbi::reserve(MDBX_txn* txn, const keymou& key, valuemou& value,
+    MDBX_put_flags_t flags)
+{
+    // байты пишутся в резерв после put, журнал их не увидит: в режиме
+    // values запись без значения потеряла бы данные для реплики
+    if (changelog::records_values(txn, id_)) {
+        throw std::runtime_error(
+            "not supported while the change log records values");
+    }
+    bloom_registry::before_write(txn, id_, &key);
+    // журнал пишется до put: его запись не должна сдвинуть зарезервированную
+    // страницу; значения еще нет, поэтому в журнал попадает только ключ
+    changelog::record(txn, changelog::put, id_, &key);
+    auto rc = mdbx_put(txn, id_, key, value, flags | MDBX_RESERVE);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+}
+
+std::int64_t dbi::increment(MDBX_txn* txn, const keymou& key, std::int64_t delta)
+{
+    if (is_multi(txn, id_)) {
+        throw std::runtime_error("increment requires a single-value DBI");
+    }
+
+    std::int64_t counter{};
+    valuemou val{};
+    auto rc = mdbx_get(txn, id_, key, val);
+    if (rc == MDBX_SUCCESS) {
+        if (val.size() != sizeof(counter)) {
+            throw std::runtime_error("value is not a 64-bit counter");
+        }
+        std::memcpy(&counter, val.data(), sizeof(counter));
+    } else if (rc != MDBX_NOTFOUND) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    // чтение счетчика не пачкает страницу
+    if (delta == 0) {
+        return counter;
+    }
+
+    using limits = std::numeric_limits<std::int64_t>;
+    if ((delta > 0 && counter > limits::max() - delta) ||
+        (delta < 0 && counter < limits::min() - delta)) {
+        throw std::overflow_error("counter overflow");
+    }
+    counter += delta;
+
+    std::uint64_t bits{};
+    std::memcpy(&bits, &counter, sizeof(bits));
+    valuemou next{bits};
+    put(txn, key, next, MDBX_UPSERT);
+    return counter;
+}
+
+bool dbi::compare_and_swap(MDBX_txn* txn, const keymou& key,
+    const valuemou* expected, valuemou* next)
+{
+    if (is_multi(txn, id_)) {
+        if (!expected) {
+            return next && try_put(txn, key, *next, MDBX_NODUPDATA);
+        }
+        // CURRENT | NOOVERWRITE: old_data выбирает значение ключа,
+        // new_data == nullptr удаляет его
+        if (next) {
+            bloom_registry::before_write(txn, id_, &key);
+        } else {
+            bloom_registry::before_delete(txn, id_);
+        }
+        valuemou old{*expected};
+        auto rc = mdbx_replace(txn, id_, key, next, &old,
+            MDBX_CURRENT | MDBX_NOOVERWRITE);
+        if (rc == MDBX_NOTFOUND) {
+            return false;
+        }
+        if (rc != MDBX_SUCCESS) {
+            throw std::runtime_error(mdbx_strerror(rc));
+        }
+        changelog::record(txn, changelog::del, id_, &key, expected);
+        if (next) {
+            changelog::record(txn, changelog::put, id_, &key, next);
+        }
+        return true;
+    }
+
+    // текущее значение нужно для сравнения до записи, поэтому здесь
+    // get + put(MDBX_CURRENT): mdbx_replace лишь скопировал бы его еще раз
+    valuemou current{};
+    auto rc = mdbx_get(txn, id_, key, current);
+    if (rc == MDBX_NOTFOUND) {
+        return !expected && next && try_put(txn, key, *next, MDBX_NOOVERWRITE);
+    }
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    if (!expected || current != *expected) {
+        return false;
+    }
+    if (!next) {
+        return del(txn, key);
+    }
+    return try_put(txn, key, *next, MDBX_CURRENT);
+}
+
+void dbi::put_dups(MDBX_txn* txn, const keymou& key,
+    const std::uint64_t* values, std::size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    bloom_registry::before_write(txn, id_, &key);
+    // data[0] - первый элемент и его размер, data[1].iov_len - число элементов
+    MDBX_val data[2];
+    data[0].iov_base = const_cast<std::uint64_t*>(values);
+    data[0].iov_len = sizeof(std::uint64_t);
+    data[1].iov_base = nullptr;
+    data[1].iov_len = count;
+    auto rc = mdbx_put(txn, id_, key, data, MDBX_MULTIPLE);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    if (changelog::active(txn, id_)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            valuemou value{values[i]};
+            changelog::record(txn, changelog::put, id_, &key, &value);
+        }
+    }
+}
+
 cursormou_managed dbi::open_cursor(MDBX_txn* txn) const
 {
     return open_cursor(txn, mdbx::map_handle{id_});
@@ -61,10 +226,19 @@ cursormou_managed dbi::open_cursor(MDBX_txn *txn, mdbx::map_handle dbi)
 
 void dbi::drop(MDBX_txn* txn, bool delete_db)
 {
+    if (!delete_db) {
+        bloom_registry::before_delete(txn, id_);
+    }
     auto rc = mdbx_drop(txn, id_, delete_db);
     if (rc != MDBX_SUCCESS) {
         throw std::runtime_error(mdbx_strerror(rc));
     }
+    changelog::record(txn, delete_db ? changelog::drop : changelog::clear,
+        id_, nullptr);
+    if (delete_db) {
+        bloom_registry::dropped(mdbx_txn_env(txn), id_);
+        bloom_.reset();
+    }
 }
 
 } // namespace mdbxmou
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bloom_filter.hpp"
 #include "valuemou.hpp"
 #include <memory>
 
@@ -9,6 +10,8 @@ class dbi
 {
 protected:
     MDBX_dbi id_{};
+    // фильтр отрицательных чтений, если DBI открыт с bloom
+    std::shared_ptr<bloom_filter> bloom_{};
     
 public:
     dbi() = default;
@@ -17,6 +20,14 @@ public:
         id_ = id;
     }
 
+    void attach_bloom(std::shared_ptr<bloom_filter> bloom) noexcept {
+        bloom_ = std::move(bloom);
+    }
+
+    const std::shared_ptr<bloom_filter>& bloom() const noexcept {
+        return bloom_;
+    }
+
     static MDBX_stat get_stat(const MDBX_txn* txn, MDBX_dbi dbi);
 
     MDBX_stat get_stat(const MDBX_txn* txn) const
@@ -34,8 +45,33 @@ public:
     void put(MDBX_txn* txn, const keymou& key, valuemou& value, 
         MDBX_put_flags_t flags = MDBX_UPSERT);
 
+    // как put, но MDBX_KEYEXIST (noOverwrite/noDupData) - это false
+    bool try_put(MDBX_txn* txn, const keymou& key, valuemou& value,
+        MDBX_put_flags_t flags = MDBX_UPSERT);
+
     bool del(MDBX_txn* txn, const keymou& key);
 
+    // MDBX_RESERVE: value.size() - размер, после вызова value указывает на
+    // место в грязной странице, которое надо заполнить до следующей записи
+    void reserve(MDBX_txn* txn, const keymou& key, valuemou& value,
+        MDBX_put_flags_t flags = MDBX_UPSERT);
+
+    // счетчик: значение - 8 байт int64 в порядке ordinal-значений,
+    // отсутствующий ключ считается 0; возвращает новое значение
+    std::int64_t increment(MDBX_txn* txn, const keymou& key, std::int64_t delta);
+
+    // заменяет значение на next, если текущее совпадает с expected;
+    // nullptr в expected - ключа нет, в next - удалить.
+    // В multi-value DBI expected выбирает заменяемое значение ключа.
+    bool compare_and_swap(MDBX_txn* txn, const keymou& key,
+        const valuemou* expected, valuemou* next);
+
+    // MDBX_MULTIPLE: все значения ключа одним вызовом, только для
+    // MDBX_DUPFIXED | MDBX_INTEGERDUP (multiOrdinal); уже существующие
+    // значения пропускаются
+    void put_dups(MDBX_txn* txn, const keymou& key,
+        const std::uint64_t* values, std::size_t count);
+
     cursormou_managed open_cursor(MDBX_txn* txn) const;
     
     // Static version for map_handle
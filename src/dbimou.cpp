@@ -1,9 +1,17 @@
 #include "dbimou.hpp"
+#include "changelog.hpp"
+#include "rangemou.hpp"
+#include "objmou.hpp"
+#include "tuplemou.hpp"
 #include "envmou.hpp"
 #include "txnmou.hpp"
 #include "typemou.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <vector>
 
 namespace mdbxmou {
 
@@ -43,27 +51,16 @@ bool parse_bool_option(const Napi::Env& env, const Napi::Object& options, const
     return value.As<Napi::Boolean>().Value();
 }
 
-struct range_options final
-{
-    bool has_start{};
-    bool has_end{};
-    bool reverse{};
-    bool include_start{true};
-    bool include_end{true};
-    std::size_t limit{std::numeric_limits<std::size_t>::max()};
-    std::size_t offset{};
-    // Keep owning data only; bind keymou after range_options moves.
-    std::uint64_t start_num{};
-    std::uint64_t end_num{};
-    buffer_type start_buf{};
-    buffer_type end_buf{};
-};
-
 void parse_range_key(const Napi::Env& env, const Napi::Value& value,
-    bool ordinal, std::uint64_t& number, buffer_type& buffer)
+    const dbimou& self, std::uint64_t& number, buffer_type& buffer)
 {
-    if (ordinal) {
-        keymou::from(value, env, number);
+    if (mdbx::is_ordinal(self.get_key_mode())) {
+        keymou::from(value, env, number, self.get_key_mode());
+        return;
+    }
+
+    if (self.get_key_flag() & base_flag::tuple) {
+        tuplemou::encode(value, buffer);
         return;
     }
 
@@ -81,6 +78,8 @@ void parse_range_key(const Napi::Env& env, const Napi::Value& value,
     keymou::from(value, env, buffer);
 }
 
+} // namespace
+
 range_options parse_range_options(const Napi::Env& env, const Napi::Value& arg0, const dbimou& self)
 {
     range_options options{};
@@ -109,25 +108,54 @@ range_options parse_range_options(const Napi::Env& env, const Napi::Value& arg0,
     options.reverse = parse_bool_option(env, obj, "reverse", false);
     options.include_start = parse_bool_option(env, obj, "includeStart", true);
     options.include_end = parse_bool_option(env, obj, "includeEnd", true);
-    const auto ordinal = mdbx::is_ordinal(self.get_key_mode());
 
     auto start = obj.Get("start");
     if (!start.IsUndefined() && !start.IsNull()) {
         options.has_start = true;
-        parse_range_key(env, start, ordinal,
+        parse_range_key(env, start, self,
             options.start_num, options.start_buf);
     }
 
     auto end = obj.Get("end");
     if (!end.IsUndefined() && !end.IsNull()) {
         options.has_end = true;
-        parse_range_key(env, end, ordinal,
+        parse_range_key(env, end, self,
             options.end_num, options.end_buf);
     }
 
+    auto prefix = obj.Get("prefix");
+    if (!prefix.IsUndefined() && !prefix.IsNull()) {
+        // префикс имеет смысл только при побайтовом порядке ключей
+        if (self.get_key_mode().val != 0) {
+            throw Napi::TypeError::New(env,
+                "prefix requires the default keyMode");
+        }
+        std::uint64_t unused{};
+        options.has_prefix = true;
+        parse_range_key(env, prefix, self, unused, options.prefix_buf);
+        auto& next = options.prefix_end_buf;
+        next = options.prefix_buf;
+        if (self.get_key_flag() & base_flag::tuple) {
+            // коды элементов кортежа меньше 0xff: продолжения префикса
+            // лежат в [prefix, prefix 0xff)
+            options.tuple_prefix = true;
+            next.push_back(static_cast<char>(0xff));
+        } else {
+            while (!next.empty() && static_cast<std::uint8_t>(next.back()) == 0xff) {
+                next.pop_back();
+            }
+            if (!next.empty()) {
+                next.back() = static_cast<char>(
+                    static_cast<std::uint8_t>(next.back()) + 1);
+            }
+        }
+    }
+
     return options;
 }
 
+namespace {
+
 bool cursor_get(cursormou_managed& cursor, MDBX_cursor_op op, mdbx::slice& key, mdbx::slice& value)
 {
     auto rc = ::mdbx_cursor_get(cursor, &key, &value, op);
@@ -188,6 +216,54 @@ MDBX_cursor_op range_turn_op(const range_options& options)
     return options.reverse ? MDBX_PREV : MDBX_NEXT;
 }
 
+// сужает начальную позицию до префикса, если граница start/end шире него
+void range_seek_prefix(MDBX_txn* txn, MDBX_dbi dbi,
+    const range_options& options, MDBX_cursor_op& op, mdbx::slice& key)
+{
+    const keymou prefix{options.prefix_buf};
+    const keymou prefix_end{options.prefix_end_buf};
+    if (options.reverse) {
+        if (prefix_end.empty()) {
+            return;
+        }
+        if (!options.has_end || ::mdbx_cmp(txn, dbi,
+                static_cast<const MDBX_val*>(&key),
+                static_cast<const MDBX_val*>(&prefix_end)) >= 0) {
+            key = prefix_end;
+            op = MDBX_TO_KEY_LESSER_THAN;
+        }
+        return;
+    }
+
+    if (!options.has_start || ::mdbx_cmp(txn, dbi,
+            static_cast<const MDBX_val*>(&key),
+            static_cast<const MDBX_val*>(&prefix)) < 0) {
+        key = prefix;
+        op = MDBX_TO_KEY_GREATER_OR_EQUAL;
+    }
+}
+
+// ставит курсор на первую запись диапазона в порядке обхода
+bool range_seek(MDBX_txn* txn, MDBX_dbi dbi, cursormou_managed& cursor,
+    const range_options& options, const keymou& start_key,
+    const keymou& end_key, mdbx::slice& key, mdbx::slice& value)
+{
+    if (options.reverse) {
+        if (options.has_end) {
+            key = end_key;
+        }
+    } else if (options.has_start) {
+        key = start_key;
+    }
+
+    auto start_op = range_start_op(options);
+    if (options.has_prefix) {
+        range_seek_prefix(txn, dbi, options, start_op, key);
+    }
+
+    return cursor_get(cursor, start_op, key, value);
+}
+
 template<class Fn>
 std::size_t scan_range(dbimou& self, txnmou& txn, const range_options& options, Fn&& fn)
 {
@@ -195,7 +271,7 @@ std::size_t scan_range(dbimou& self, txnmou& txn, const range_options& options,
         return 0;
     }
 
-    auto cursor = self.open_cursor(txn);
+    auto cursor = txn.cached_cursor(self.get_id());
     mdbx::slice key{};
     mdbx::slice value{};
     const auto ordinal = mdbx::is_ordinal(self.get_key_mode());
@@ -204,15 +280,8 @@ std::size_t scan_range(dbimou& self, txnmou& txn, const range_options& options,
     const keymou end_key = ordinal ?
         keymou{options.end_num} : keymou{options.end_buf};
 
-    if (options.reverse) {
-        if (options.has_end) {
-            key = end_key;
-        }
-    } else if (options.has_start) {
-        key = start_key;
-    }
-
-    if (!cursor_get(cursor, range_start_op(options), key, value)) {
+    if (!range_seek(txn, self.get_id(), cursor, options,
+            start_key, end_key, key, value)) {
         return 0;
     }
 
@@ -226,6 +295,11 @@ std::size_t scan_range(dbimou& self, txnmou& txn, const range_options& options,
             break;
         }
 
+        // ключи с префиксом идут подряд, первый чужой завершает обход
+        if (options.has_prefix && !options.prefix_match(key)) {
+            break;
+        }
+
         if (skipped < options.offset) {
             ++skipped;
         } else {
@@ -321,8 +395,245 @@ Napi::Value run_range_count(const Napi::CallbackInfo& info, dbimou& self, const
     }
 }
 
+// ключ пакета getMany/hasMany: байты в общем буфере и место в ответе
+struct batch_key
+{
+    std::size_t offset{};
+    std::size_t size{};
+    std::uint32_t index{};
+};
+
+std::uint64_t encode_signed(std::int64_t value) noexcept
+{
+    return static_cast<std::uint64_t>(value) ^ keymou::sign_bit;
+}
+
+// элемент типизированного массива по правилам keyMode, как Number/BigInt
+std::uint64_t typed_ordinal(const Napi::TypedArray& arr, std::size_t i,
+    key_mode mode)
+{
+    auto* data = static_cast<const char*>(arr.ArrayBuffer().Data()) +
+        arr.ByteOffset();
+    auto type = arr.TypedArrayType();
+
+    if (type == napi_bigint64_array || type == napi_biguint64_array) {
+        if (mode.val & key_mode::float_key) {
+            throw std::runtime_error("key must be a Number");
+        }
+        std::uint64_t bits;
+        std::memcpy(&bits, data + i * sizeof(bits), sizeof(bits));
+        if (type == napi_biguint64_array) {
+            if ((mode.val & key_mode::signed_key) && (bits & keymou::sign_bit)) {
+                throw std::runtime_error("key out of int64 range");
+            }
+            return (mode.val & key_mode::signed_key) ?
+                encode_signed(static_cast<std::int64_t>(bits)) : bits;
+        }
+        auto value = static_cast<std::int64_t>(bits);
+        if (mode.val & key_mode::signed_key) {
+            return encode_signed(value);
+        }
+        if (value < 0) {
+            throw std::runtime_error("Number negative");
+        }
+        return bits;
+    }
+
+    double d{};
+    switch (type) {
+    case napi_int8_array:
+        d = reinterpret_cast<const std::int8_t*>(data)[i];
+        break;
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+        d = reinterpret_cast<const std::uint8_t*>(data)[i];
+        break;
+    case napi_int16_array: {
+        std::int16_t v;
+        std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+        d = v;
+        break;
+    }
+    case napi_uint16_array: {
+        std::uint16_t v;
+        std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+        d = v;
+        break;
+    }
+    case napi_int32_array: {
+        std::int32_t v;
+        std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+        d = v;
+        break;
+    }
+    case napi_uint32_array: {
+        std::uint32_t v;
+        std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+        d = v;
+        break;
+    }
+    case napi_float32_array: {
+        float v;
+        std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+        d = v;
+        break;
+    }
+    default:
+        std::memcpy(&d, data + i * sizeof(d), sizeof(d));
+        break;
+    }
+
+    if (mode.val & key_mode::float_key) {
+        if (std::isnan(d)) {
+            throw std::runtime_error("key must not be NaN");
+        }
+        if (d == 0) {
+            d = 0;
+        }
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        return (bits & keymou::sign_bit) ? ~bits : (bits ^ keymou::sign_bit);
+    }
+    if (mode.val & key_mode::signed_key) {
+        if (std::trunc(d) != d || d < -9223372036854775808.0 ||
+            d >= 9223372036854775808.0) {
+            throw std::runtime_error("key must be an int64 integer");
+        }
+        return encode_signed(static_cast<std::int64_t>(d));
+    }
+    if (d < 0) {
+        throw std::runtime_error("Number negative");
+    }
+    // NaN и значения от 2^64 при приведении - неопределенное поведение
+    if (std::trunc(d) != d || d >= 18446744073709551616.0) {
+        throw std::runtime_error("key must be a uint64 integer");
+    }
+    return static_cast<std::uint64_t>(d);
+}
+
+// кодирует ключи Array (или типизированного массива для ordinal) в arena
+// и сортирует их компаратором DBI: соседние поиски курсора попадают на уже
+// загруженные страницы
+void collect_keys(const Napi::Env& env, const dbimou& self, MDBX_txn* txn,
+    const Napi::Value& arg0, buffer_type& arena, std::vector<batch_key>& keys)
+{
+    buffer_type buf;
+    std::uint64_t num{};
+    auto append = [&](const mdbx::slice& key, std::uint32_t index) {
+        keys.push_back({arena.size(), key.size(), index});
+        arena.insert(arena.end(), key.char_ptr(), key.end_char_ptr());
+    };
+
+    if (arg0.IsTypedArray()) {
+        auto mode = self.get_key_mode();
+        if (!mdbx::is_ordinal(mode)) {
+            throw std::runtime_error(
+                "typed array keys require an ordinal keyMode");
+        }
+        auto arr = arg0.As<Napi::TypedArray>();
+        auto length = arr.ElementLength();
+        keys.reserve(length);
+        arena.reserve(length * sizeof(num));
+        for (std::size_t i = 0; i < length; ++i) {
+            num = typed_ordinal(arr, i, mode);
+            append(mdbx::slice{&num, sizeof(num)}, static_cast<std::uint32_t>(i));
+        }
+    } else if (arg0.IsArray()) {
+        auto arr = arg0.As<Napi::Array>();
+        auto length = arr.Length();
+        keys.reserve(length);
+        for (std::uint32_t i = 0; i < length; ++i) {
+            append(self.make_key(env, arr.Get(i), buf, num), i);
+        }
+    } else {
+        throw std::runtime_error("keys must be an Array or a typed array");
+    }
+
+    auto dbi = self.get_id();
+    const auto* base = arena.data();
+    std::sort(keys.begin(), keys.end(),
+        [txn, dbi, base](const batch_key& a, const batch_key& b) {
+            mdbx::slice x{base + a.offset, a.size};
+            mdbx::slice y{base + b.offset, b.size};
+            return mdbx_cmp(txn, dbi, &x, &y) < 0;
+        });
+}
+
 } // namespace
 
+std::size_t delete_range(MDBX_txn* txn, MDBX_dbi dbi, bool ordinal,
+    const range_options& options)
+{
+    if (options.limit == 0) {
+        return 0;
+    }
+
+    unsigned db_flags{};
+    unsigned db_state{};
+    mdbx::error::success_or_throw(
+        ::mdbx_dbi_flags_ex(txn, dbi, &db_flags, &db_state));
+    const bool multi = (db_flags & MDBX_DUPSORT) != 0;
+
+    auto cursor = dbi::open_cursor(txn, mdbx::map_handle{dbi});
+    mdbx::slice key{};
+    mdbx::slice value{};
+    const keymou start_key = ordinal ?
+        keymou{options.start_num} : keymou{options.start_buf};
+    const keymou end_key = ordinal ?
+        keymou{options.end_num} : keymou{options.end_buf};
+
+    if (!range_seek(txn, dbi, cursor, options,
+            start_key, end_key, key, value)) {
+        return 0;
+    }
+
+    // в multi-value DBI ключ удаляется целиком, обход идет по ключам
+    const auto turn_op = !multi ? range_turn_op(options) :
+        options.reverse ? MDBX_PREV_NODUP : MDBX_NEXT_NODUP;
+    const auto del_flags = multi ? MDBX_ALLDUPS : MDBX_CURRENT;
+    // журналу нужна копия ключа: после удаления slice указывает в страницу
+    const bool logged = changelog::active(txn, dbi);
+    buffer_type key_buf{};
+
+    std::size_t skipped{};
+    std::size_t count{};
+    while (true) {
+        if (outside_range(txn, dbi, key, options, start_key, end_key)) {
+            break;
+        }
+        if (options.has_prefix && !options.prefix_match(key)) {
+            break;
+        }
+
+        if (skipped < options.offset) {
+            ++skipped;
+        } else {
+            if (count == 0) {
+                bloom_registry::before_delete(txn, dbi);
+            }
+            if (logged) {
+                key_buf.assign(key.char_ptr(), key.end_char_ptr());
+            }
+            // после удаления курсор стоит на следующей записи,
+            // turn_op переходит к ней без пропуска
+            mdbx::error::success_or_throw(::mdbx_cursor_del(cursor, del_flags));
+            if (logged) {
+                keymou deleted{key_buf};
+                changelog::record(txn, changelog::del, dbi, &deleted);
+            }
+            if (++count >= options.limit) {
+                break;
+            }
+        }
+
+        if (!cursor_get(cursor, turn_op, key, value)) {
+            break;
+        }
+    }
+
+    return count;
+}
+
 const napi_type_tag dbimou::type_tag_{
     0x6f43d8a92c1e475bULL,
     0xb5810ed347fa962cULL,
@@ -356,6 +667,153 @@ dbimou* dbimou::unwrap_checked(
 	return static_cast<dbimou*>(wrapper);
 }
 
+keymou dbimou::make_key(const Napi::Env& env, const Napi::Value& arg0,
+    buffer_type& buf, std::uint64_t& num) const
+{
+    if (mdbx::is_ordinal(key_mode_)) {
+        return keymou::from(arg0, env, num, key_mode_);
+    }
+    if (key_flag_ & base_flag::tuple) {
+        return tuplemou::encode(arg0, buf);
+    }
+    return keymou::from(arg0, env, buf);
+}
+
+valuemou dbimou::make_value(const Napi::Env& env, const Napi::Value& arg0,
+    buffer_type& buf, std::uint64_t& num) const
+{
+    if (value_flag_ & base_flag::object) {
+        return objmou::encode(arg0, buf);
+    }
+    return valuemou::from(arg0, env, buf, num, is_ordinal(value_mode_));
+}
+
+std::int64_t dbimou::parse_delta(const Napi::Env& env, const Napi::Value& arg0)
+{
+    if (arg0.IsUndefined()) {
+        return 1;
+    }
+    if (arg0.IsBigInt()) {
+        bool lossless;
+        auto delta = arg0.As<Napi::BigInt>().Int64Value(&lossless);
+        if (!lossless) {
+            throw Napi::RangeError::New(env, "delta out of int64 range");
+        }
+        return delta;
+    }
+    if (!arg0.IsNumber()) {
+        throw Napi::TypeError::New(env, "delta must be a Number or BigInt");
+    }
+    auto delta = arg0.As<Napi::Number>().DoubleValue();
+    // 2^63 точно представим в double, границы проверяются до приведения
+    if (std::trunc(delta) != delta || delta < -9223372036854775808.0 ||
+        delta >= 9223372036854775808.0) {
+        throw Napi::RangeError::New(env, "delta must be an int64 integer");
+    }
+    return static_cast<std::int64_t>(delta);
+}
+
+std::pair<const std::uint64_t*, std::size_t> dbimou::parse_dups(
+    const Napi::Env& env, const Napi::Value& arg0,
+    std::vector<std::uint64_t>& mem)
+{
+    if (arg0.IsTypedArray()) {
+        auto arr = arg0.As<Napi::TypedArray>();
+        auto length = arr.ElementLength();
+        auto* data = static_cast<const char*>(arr.ArrayBuffer().Data()) +
+            arr.ByteOffset();
+        switch (arr.TypedArrayType()) {
+        case napi_biguint64_array:
+            // смещение BigUint64Array всегда кратно 8 - выравнивание
+            // для MDBX_INTEGERDUP соблюдено
+            return {reinterpret_cast<const std::uint64_t*>(data), length};
+        case napi_uint32_array: {
+            mem.resize(length);
+            for (std::size_t i = 0; i < length; ++i) {
+                std::uint32_t v;
+                std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+                mem[i] = v;
+            }
+            return {mem.data(), mem.size()};
+        }
+        default:
+            break;
+        }
+    } else if (arg0.IsArray()) {
+        auto arr = arg0.As<Napi::Array>();
+        auto length = arr.Length();
+        mem.resize(length);
+        for (std::uint32_t i = 0; i < length; ++i) {
+            valuemou::from(arr.Get(i), env, mem[i]);
+        }
+        return {mem.data(), mem.size()};
+    }
+    throw Napi::TypeError::New(env,
+        "values must be a BigUint64Array, Uint32Array or Array");
+}
+
+Napi::Value dbimou::read_dups(const Napi::Env& env, MDBX_cursor* cursor,
+    MDBX_cursor_op op, keymou* key) const
+{
+    // MDBX_GET_MULTIPLE отдает только дубликаты фиксированного размера
+    if (!(value_mode_.val & MDBX_DUPFIXED)) {
+        throw std::runtime_error("fixed-size multi-value DBI required");
+    }
+
+    keymou dummy{};
+    mdbx::slice value{};
+    auto rc = mdbx_cursor_get(cursor, key ? key : &dummy, &value, op);
+    if (rc == MDBX_NOTFOUND) {
+        return env.Undefined();
+    }
+    if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+
+    // размер записи и их число известны заранее - массив выделяется
+    // один раз и заполняется memcpy из каждой страницы
+    std::size_t count{};
+    rc = mdbx_cursor_count(cursor, &count);
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    const std::size_t item_size = value.size();
+    const std::size_t total = count * item_size;
+    auto buffer = Napi::ArrayBuffer::New(env, total);
+    auto* out = static_cast<char*>(buffer.Data());
+
+    // единственное значение лежит в самом узле без вложенного дерева,
+    // его уже вернуло позиционирование
+    if (count == 1) {
+        std::memcpy(out, value.data(), total);
+    }
+    std::size_t offset = count == 1 ? total : 0;
+    for (auto page_op = MDBX_GET_MULTIPLE; offset < total;
+        page_op = MDBX_NEXT_MULTIPLE) {
+        rc = mdbx_cursor_get(cursor, &dummy, &value, page_op);
+        if (rc == MDBX_NOTFOUND) {
+            break;
+        }
+        if (rc != MDBX_SUCCESS) {
+            throw std::runtime_error(mdbx_strerror(rc));
+        }
+        if (value.size() > total - offset) {
+            throw std::runtime_error("duplicate count mismatch");
+        }
+        std::memcpy(out + offset, value.data(), value.size());
+        offset += value.size();
+    }
+    if (offset != total) {
+        throw std::runtime_error("duplicate count mismatch");
+    }
+
+    if (is_ordinal(value_mode_) && item_size == sizeof(std::uint64_t)) {
+        return Napi::TypedArrayOf<std::uint64_t>::New(env, count, buffer, 0,
+            napi_biguint64_array);
+    }
+    return Napi::Uint8Array::New(env, total, buffer, 0);
+}
+
 Napi::Function dbimou::init(const char* class_name, Napi::Env env)
 {
 	auto func = DefineClass(env,
@@ -364,7 +822,15 @@ Napi::Function dbimou::init(const char* class_name, Napi::Env env)
 			InstanceMethod("put", &dbimou::put),
 			InstanceMethod("get", &dbimou::get),
 			InstanceMethod("getView", &dbimou::get_view),
+			InstanceMethod("reserve", &dbimou::reserve),
+			InstanceMethod("getWritableView", &dbimou::get_writable_view),
+			InstanceMethod("getMany", &dbimou::get_many),
+			InstanceMethod("hasMany", &dbimou::has_many),
 			InstanceMethod("del", &dbimou::del),
+			InstanceMethod("increment", &dbimou::increment),
+			InstanceMethod("compareAndSwap", &dbimou::compare_and_swap),
+			InstanceMethod("putDups", &dbimou::put_dups),
+			InstanceMethod("getAllDups", &dbimou::get_all_dups),
 			InstanceMethod("has", &dbimou::has),
 			InstanceMethod("forEach", &dbimou::for_each),
 			InstanceMethod("stat", &dbimou::stat),
@@ -375,7 +841,10 @@ Napi::Function dbimou::init(const char* class_name, Napi::Env env)
 			InstanceMethod("getCount", &dbimou::get_count),
 			InstanceMethod("keysRange", &dbimou::keys_range),
 			InstanceMethod("valuesRange", &dbimou::values_range),
+			InstanceMethod("delRange", &dbimou::del_range),
 			InstanceMethod("drop", &dbimou::drop),
+			InstanceMethod("bloomStats", &dbimou::bloom_stats),
+			InstanceMethod("cacheStats", &dbimou::cache_stats),
 
 			// Свойства только для чтения
 			InstanceAccessor("id", &dbimou::get_id, nullptr),
@@ -397,13 +866,12 @@ Napi::Value dbimou::put(const Napi::CallbackInfo& info)
         throw Napi::Error::New(env, "put: txnmou, key and value required");
     }
     auto txn = txnmou::unwrap_checked(env, info[0], "put");
+    txn->before_write(env);
     try {
         std::uint64_t t;
-        auto key = mdbx::is_ordinal(key_mode_) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        auto key = make_key(env, info[1], key_buf_, t);
 
-        auto val = valuemou::from(info[2], env, val_buf_, val_num_, is_ordinal(value_mode_));
+        auto val = make_value(env, info[2], val_buf_, val_num_);
         MDBX_put_flags_t flags = MDBX_UPSERT;
         if (arg_len > 3 && !info[3].IsUndefined() && !info[3].IsNull()) {
             if (!info[3].IsNumber()) {
@@ -431,9 +899,11 @@ Napi::Value dbimou::get(const Napi::CallbackInfo& info)
     try {
         auto conv = get_convmou();
         std::uint64_t t;
-        auto key = mdbx::is_ordinal(key_mode_) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        auto key = make_key(env, info[1], key_buf_, t);
+
+        if (cache_ && txn->is_readonly()) {
+            return cache_->get(env, *txn, *this, key, conv);
+        }
         
         auto val = dbi::get(*txn, key);
         if (val.is_null()) {
@@ -448,6 +918,81 @@ Napi::Value dbimou::get(const Napi::CallbackInfo& info)
     return env.Undefined();
 }
 
+Napi::Value dbimou::get_many(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 2) {
+        throw Napi::Error::New(env, "getMany: txnmou and keys required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "getMany");
+
+    try {
+        buffer_type arena;
+        std::vector<batch_key> keys;
+        collect_keys(env, *this, *txn, info[1], arena, keys);
+
+        auto conv = get_convmou();
+        auto result = Napi::Array::New(env, keys.size());
+        auto cursor = txn->cached_cursor(id_);
+        // одно чтение состояния DBI на весь пакет
+        bloom_filter::txn_state bloom_txn{};
+        if (bloom_) {
+            bloom_txn = bloom_->state(*txn);
+        }
+        for (auto& k : keys) {
+            mdbx::slice key{arena.data() + k.offset, k.size};
+            mdbx::slice value{};
+            if ((bloom_ && !bloom_->may_contain(bloom_txn, key)) ||
+                !cursor_get(cursor, MDBX_SET_KEY, key, value)) {
+                result.Set(k.index, env.Undefined());
+                continue;
+            }
+            result.Set(k.index, conv.convert_value(env, value));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("getMany: ") + e.what());
+    }
+}
+
+Napi::Value dbimou::has_many(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 2) {
+        throw Napi::Error::New(env, "hasMany: txnmou and keys required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "hasMany");
+
+    try {
+        buffer_type arena;
+        std::vector<batch_key> keys;
+        collect_keys(env, *this, *txn, info[1], arena, keys);
+
+        // бит i (младший первым) - ключ i найден
+        auto bitmap = Napi::Uint8Array::New(env, (keys.size() + 7) / 8);
+        auto* bits = bitmap.Data();
+        std::memset(bits, 0, bitmap.ByteLength());
+        auto cursor = txn->cached_cursor(id_);
+        // одно чтение состояния DBI на весь пакет
+        bloom_filter::txn_state bloom_txn{};
+        if (bloom_) {
+            bloom_txn = bloom_->state(*txn);
+        }
+        for (auto& k : keys) {
+            mdbx::slice key{arena.data() + k.offset, k.size};
+            mdbx::slice value{};
+            if ((bloom_ && !bloom_->may_contain(bloom_txn, key)) ||
+                !cursor_get(cursor, MDBX_SET, key, value)) {
+                continue;
+            }
+            bits[k.index >> 3] |= static_cast<std::uint8_t>(1u << (k.index & 7));
+        }
+        return bitmap;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("hasMany: ") + e.what());
+    }
+}
+
 Napi::Value dbimou::get_view(const Napi::CallbackInfo& info)
 {
 	Napi::Env env = info.Env();
@@ -472,9 +1017,7 @@ Napi::Value dbimou::get_view(const Napi::CallbackInfo& info)
 		}
 
 		std::uint64_t key_number{};
-		auto key = mdbx::is_ordinal(key_mode_)
-			? keymou::from(info[1], env, key_number)
-			: keymou::from(info[1], env, key_buf_);
+		auto key = make_key(env, info[1], key_buf_, key_number);
 		auto value = dbi::get(*txn, key);
 		if (value.is_null()) {
 			return env.Undefined();
@@ -489,6 +1032,101 @@ Napi::Value dbimou::get_view(const Napi::CallbackInfo& info)
 	}
 }
 
+Napi::Value dbimou::reserve(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+	try {
+		if (info.Length() < 3) {
+			throw Napi::TypeError::New(
+				env, "reserve: txnmou, key and size required");
+		}
+
+		auto* txn = txnmou::unwrap_checked(env, info[0], "reserve");
+		if (!txn->is_active()) {
+			throw Napi::Error::New(env, "reserve: txn already completed");
+		}
+		if (txn->is_readonly()) {
+			throw Napi::TypeError::New(
+				env, "reserve: write transaction required");
+		}
+		// MDBX_RESERVE несовместим с MDBX_DUPSORT
+		if (value_mode_.val & MDBX_DUPSORT) {
+			throw Napi::TypeError::New(
+				env, "reserve: multi-value DBI is not supported");
+		}
+		if (!info[2].IsNumber()) {
+			throw Napi::TypeError::New(env, "reserve: size must be a number");
+		}
+		auto size = info[2].As<Napi::Number>().DoubleValue();
+		if (std::trunc(size) != size || size < 0 ||
+			size > static_cast<double>(std::numeric_limits<std::uint32_t>::max())) {
+			throw Napi::RangeError::New(
+				env, "reserve: size must be an integer in [0, 2^32)");
+		}
+
+		txn->before_write(env);
+		std::uint64_t key_number{};
+		auto key = make_key(env, info[1], key_buf_, key_number);
+		valuemou value{};
+		value.iov_len = static_cast<std::size_t>(size);
+		dbi::reserve(*txn, key, value);
+		return txn->issue_reserved_view(env, value);
+	} catch (const Napi::Error&) {
+		throw;
+	} catch (const std::exception& error) {
+		throw Napi::Error::New(env, std::string("reserve: ") + error.what());
+	}
+}
+
+Napi::Value dbimou::get_writable_view(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+	try {
+		if (info.Length() < 2) {
+			throw Napi::TypeError::New(
+				env, "getWritableView: transaction and key required");
+		}
+
+		auto* txn = txnmou::unwrap_checked(env, info[0], "getWritableView");
+		if (!txn->is_active()) {
+			throw Napi::Error::New(env, "getWritableView: txn already completed");
+		}
+		if (txn->is_readonly()) {
+			throw Napi::TypeError::New(
+				env, "getWritableView: write transaction required");
+		}
+		if (value_mode_.val & MDBX_DUPSORT) {
+			throw Napi::TypeError::New(
+				env, "getWritableView: multi-value DBI is not supported");
+		}
+
+		txn->before_write(env);
+		std::uint64_t key_number{};
+		auto key = make_key(env, info[1], key_buf_, key_number);
+		auto current = dbi::get(*txn, key);
+		if (current.is_null()) {
+			return env.Undefined();
+		}
+
+		// MDBX_CURRENT | MDBX_RESERVE того же размера копирует страницу
+		// при записи, но не обещает сохранить байты значения (большие
+		// значения получают новые страницы) - переносим их сами
+		val_buf_.assign(current.char_ptr(), current.end_char_ptr());
+		valuemou value{};
+		value.iov_len = val_buf_.size();
+		dbi::reserve(*txn, key, value, MDBX_CURRENT);
+		if (!val_buf_.empty()) {
+			std::memcpy(value.data(), val_buf_.data(), val_buf_.size());
+		}
+		return txn->issue_reserved_view(env, value);
+	} catch (const Napi::Error&) {
+		throw;
+	} catch (const std::exception& error) {
+		throw Napi::Error::New(
+			env, std::string("getWritableView: ") + error.what());
+	}
+}
+
 Napi::Value dbimou::del(const Napi::CallbackInfo& info)
 {
 	Napi::Env env = info.Env();
@@ -497,12 +1135,11 @@ Napi::Value dbimou::del(const Napi::CallbackInfo& info)
 		throw Napi::Error::New(env, "del: txnmou and key required");
 	}
 	auto txn = txnmou::unwrap_checked(env, info[0], "del");
+	txn->before_write(env);
 
     try {
         std::uint64_t t;
-        auto key = mdbx::is_ordinal(key_mode_) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        auto key = make_key(env, info[1], key_buf_, t);
         
         bool result = dbi::del(*txn, key);
         return Napi::Value::From(env, result);
@@ -513,6 +1150,120 @@ Napi::Value dbimou::del(const Napi::CallbackInfo& info)
     return env.Undefined();
 }
 
+Napi::Value dbimou::increment(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 2) {
+        throw Napi::Error::New(env, "increment: txnmou and key required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "increment");
+    txn->before_write(env);
+
+    try {
+        std::uint64_t t;
+        auto key = make_key(env, info[1], key_buf_, t);
+        auto delta = parse_delta(env, info.Length() > 2 ? info[2] : env.Undefined());
+
+        auto counter = dbi::increment(*txn, key, delta);
+        return info.Length() > 2 && info[2].IsBigInt() ?
+            Napi::BigInt::New(env, counter) :
+            get_convmou().convert_counter(env, counter);
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("increment: ") + e.what());
+    }
+}
+
+Napi::Value dbimou::compare_and_swap(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 4) {
+        throw Napi::Error::New(env,
+            "compareAndSwap: txnmou, key, expected and next required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "compareAndSwap");
+    txn->before_write(env);
+
+    try {
+        std::uint64_t t;
+        auto key = make_key(env, info[1], key_buf_, t);
+
+        // undefined в expected - ключа нет, в next - удалить
+        buffer_type expected_buf;
+        std::uint64_t expected_num{};
+        valuemou expected{};
+        const bool has_expected = !info[2].IsUndefined();
+        if (has_expected) {
+            expected = make_value(env, info[2], expected_buf, expected_num);
+        }
+        valuemou next{};
+        const bool has_next = !info[3].IsUndefined();
+        if (has_next) {
+            next = make_value(env, info[3], val_buf_, val_num_);
+        }
+
+        bool swapped = dbi::compare_and_swap(*txn, key,
+            has_expected ? &expected : nullptr,
+            has_next ? &next : nullptr);
+        return Napi::Boolean::New(env, swapped);
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("compareAndSwap: ") + e.what());
+    }
+}
+
+Napi::Value dbimou::put_dups(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 3) {
+        throw Napi::Error::New(env, "putDups: txnmou, key and values required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "putDups");
+    // MDBX_MULTIPLE работает только с дубликатами фиксированного размера
+    if (!is_ordinal(value_mode_) || !(value_mode_.val & MDBX_DUPFIXED)) {
+        throw Napi::TypeError::New(env, "putDups: multiOrdinal valueMode required");
+    }
+    txn->before_write(env);
+
+    try {
+        std::uint64_t t;
+        auto key = make_key(env, info[1], key_buf_, t);
+        std::vector<std::uint64_t> mem;
+        auto values = parse_dups(env, info[2], mem);
+        dbi::put_dups(*txn, key, values.first, values.second);
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("putDups: ") + e.what());
+    }
+    return env.Undefined();
+}
+
+Napi::Value dbimou::get_all_dups(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 2) {
+        throw Napi::Error::New(env, "getAllDups: txnmou and key required");
+    }
+    auto txn = txnmou::unwrap_checked(env, info[0], "getAllDups");
+
+    try {
+        std::uint64_t t;
+        auto key = make_key(env, info[1], key_buf_, t);
+        if (bloom_ && !bloom_->may_contain(*txn, key)) {
+            return env.Undefined();
+        }
+        auto cursor = txn->cached_cursor(id_);
+        return read_dups(env, cursor, MDBX_SET_KEY, &key);
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("getAllDups: ") + e.what());
+    }
+}
+
 Napi::Value dbimou::has(const Napi::CallbackInfo& info) 
 {
     Napi::Env env = info.Env();
@@ -524,9 +1275,7 @@ Napi::Value dbimou::has(const Napi::CallbackInfo& info)
 
     try {
         std::uint64_t t;
-        auto key = mdbx::is_ordinal(key_mode_) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        auto key = make_key(env, info[1], key_buf_, t);
 
         bool result = dbi::has(*txn, key);
         return Napi::Value::From(env, result);
@@ -560,7 +1309,7 @@ Napi::Value dbimou::for_each(const Napi::CallbackInfo& info)
                 return Napi::Number::New(env, 0);
             }
 
-            auto cursor = open_cursor(*txn);
+            auto cursor = txn->cached_cursor(id_);
             uint32_t index{};
             cursor.scan_until([&](const mdbx::pair& f) {
                 keymou key{f.key};
@@ -615,7 +1364,7 @@ Napi::Value dbimou::for_each_from(const Napi::CallbackInfo& info)
     
     try {
         auto conv = get_convmou();
-        auto cursor = dbi::open_cursor(*txn);
+        auto cursor = txn->cached_cursor(id_);
         auto stat = dbi::get_stat(*txn);
         
         // Проверяем, есть ли записи в базе данных
@@ -625,9 +1374,7 @@ Napi::Value dbimou::for_each_from(const Napi::CallbackInfo& info)
         
         // Парсим начальный ключ
         std::uint64_t t;
-        keymou from_key = (mdbx::is_ordinal(key_mode_)) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        keymou from_key = make_key(env, info[1], key_buf_, t);
         
         // Парсим cursor mode (если передан)
         using move_operation = mdbx::cursor::move_operation;
@@ -701,22 +1448,7 @@ Napi::Value dbimou::stat(const Napi::CallbackInfo& info)
     
     try {
         auto stat = dbi::get_stat(*txn);
-        
-        Napi::Object result = Napi::Object::New(env);
-        
-        result.Set("pageSize", Napi::Number::New(env, stat.ms_psize));
-        result.Set("depth", Napi::Number::New(env, stat.ms_depth));
-        result.Set("branchPages", Napi::Number::New(env, 
-            static_cast<double>(stat.ms_branch_pages)));
-        result.Set("leafPages", Napi::Number::New(env, 
-            static_cast<double>(stat.ms_leaf_pages)));
-        result.Set("overflowPages", Napi::Number::New(env, 
-            static_cast<double>(stat.ms_overflow_pages)));
-        result.Set("entries", Napi::Number::New(env, 
-            static_cast<double>(stat.ms_entries)));
-        result.Set("modTxnId", Napi::Number::New(env, 
-            static_cast<double>(stat.ms_mod_txnid)));
-        return result;
+        return convmou::convert_stat(env, stat);
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, std::string("stat: ") + e.what());
     }
@@ -766,7 +1498,7 @@ Napi::Value dbimou::keys(const Napi::CallbackInfo& info)
         }
 
         // Используем batch версию для лучшей производительности
-        auto cursor = open_cursor(*txn);
+        auto cursor = txn->cached_cursor(id_);
 
         // Буфер для batch - MDBXMOU_BATCH_LIMIT/2 пар (key, value)
 #ifndef MDBXMOU_BATCH_LIMIT
@@ -809,13 +1541,11 @@ Napi::Value dbimou::keys_from(const Napi::CallbackInfo& info)
 
     try {
         auto conv = get_convmou();
-        auto cursor = dbi::open_cursor(*txn);
+        auto cursor = txn->cached_cursor(id_);
         
         // Парсим аргументы: txn, from, limit, cursorMode
         std::uint64_t t;
-        keymou from_key = (mdbx::is_ordinal(key_mode_)) ?
-            keymou::from(info[1], env, t) : 
-            keymou::from(info[1], env, key_buf_);
+        keymou from_key = make_key(env, info[1], key_buf_, t);
         
         std::size_t count = SIZE_MAX;
         if (info.Length() > 2 && !info[2].IsUndefined()) {
@@ -893,6 +1623,30 @@ Napi::Value dbimou::get_count(const Napi::CallbackInfo& info)
     return run_range_count(info, *this, "getCount");
 }
 
+Napi::Value dbimou::del_range(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 1) {
+        throw Napi::TypeError::New(env, "delRange: txnmou required");
+    }
+
+    auto txn = txnmou::unwrap_checked(env, info[0], "delRange");
+    txn->before_write(env);
+
+    try {
+        auto options = info.Length() > 1 ?
+            parse_range_options(env, info[1], *this) :
+            range_options{};
+        auto count = delete_range(*txn, get_id(),
+            mdbx::is_ordinal(key_mode_), options);
+        return Napi::Number::New(env, static_cast<double>(count));
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("delRange: ") + e.what());
+    }
+}
+
 Napi::Value dbimou::keys_range(const Napi::CallbackInfo& info)
 {
     return run_range_query(info, *this, "keysRange", range_output::keys);
@@ -910,6 +1664,8 @@ Napi::Value dbimou::drop(const Napi::CallbackInfo& info)
         throw Napi::TypeError::New(env, "First argument must be a transaction");
     }
     auto txn = txnmou::unwrap_checked(env, info[0], "drop");
+    txn->before_write(env);
+    txn->close_cached_cursors();
     bool delete_db = false;
     if (info.Length() > 1 && info[1].IsBoolean()) {
         delete_db = info[1].As<Napi::Boolean>().Value();
@@ -922,4 +1678,41 @@ Napi::Value dbimou::drop(const Napi::CallbackInfo& info)
     return env.Undefined();
 }
 
+Napi::Value dbimou::bloom_stats(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (!bloom_) {
+        return env.Undefined();
+    }
+    auto stats = bloom_->get_stats();
+    auto rc = Napi::Object::New(env);
+    rc.Set("ready", Napi::Boolean::New(env, stats.ready));
+    rc.Set("building", Napi::Boolean::New(env, stats.building));
+    rc.Set("bitsPerKey", Napi::Number::New(env, stats.bits_per_key));
+    rc.Set("capacity", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+    rc.Set("keys", Napi::Number::New(env, static_cast<double>(stats.keys)));
+    rc.Set("baseTxnId", Napi::Number::New(env, static_cast<double>(stats.base)));
+    rc.Set("coveredTxnId", Napi::Number::New(env, static_cast<double>(stats.covered)));
+    rc.Set("probes", Napi::Number::New(env, static_cast<double>(stats.probes)));
+    rc.Set("negatives", Napi::Number::New(env, static_cast<double>(stats.negatives)));
+    rc.Set("builds", Napi::Number::New(env, static_cast<double>(stats.builds)));
+    return rc;
+}
+
+Napi::Value dbimou::cache_stats(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (!cache_) {
+        return env.Undefined();
+    }
+    auto stats = cache_->get_stats();
+    auto rc = Napi::Object::New(env);
+    rc.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+    rc.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+    rc.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    rc.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+    rc.Set("maxBytes", Napi::Number::New(env, static_cast<double>(stats.max_bytes)));
+    return rc;
+}
+
 } // namespace mdbxmou
@@ -4,7 +4,10 @@
 #include "dbi.hpp"
 #include "querymou.hpp"
 #include "env_arg0.hpp"
+#include "value_cache.hpp"
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace mdbxmou {
 
@@ -28,6 +31,9 @@ class dbimou final
     buffer_type key_buf_{};
     buffer_type val_buf_{};
     std::uint64_t val_num_{};
+
+    // кэш get() в читающих транзакциях, если открыт с cache
+    std::unique_ptr<value_cache> cache_{};
     
 public:   
     static bool is_instance(const Napi::Value& value) noexcept;
@@ -76,7 +82,15 @@ public:
 	Napi::Value put(const Napi::CallbackInfo&);
 	Napi::Value get(const Napi::CallbackInfo&);
 	Napi::Value get_view(const Napi::CallbackInfo&);
+	Napi::Value reserve(const Napi::CallbackInfo&);
+	Napi::Value get_writable_view(const Napi::CallbackInfo&);
+	Napi::Value get_many(const Napi::CallbackInfo&);
+	Napi::Value has_many(const Napi::CallbackInfo&);
 	Napi::Value del(const Napi::CallbackInfo&);
+	Napi::Value increment(const Napi::CallbackInfo&);
+	Napi::Value compare_and_swap(const Napi::CallbackInfo&);
+	Napi::Value put_dups(const Napi::CallbackInfo&);
+	Napi::Value get_all_dups(const Napi::CallbackInfo&);
 	Napi::Value has(const Napi::CallbackInfo&);
 	Napi::Value for_each(const Napi::CallbackInfo&);
 	Napi::Value stat(const Napi::CallbackInfo&);
@@ -87,7 +101,10 @@ public:
 	Napi::Value get_count(const Napi::CallbackInfo&);
 	Napi::Value keys_range(const Napi::CallbackInfo&);
 	Napi::Value values_range(const Napi::CallbackInfo&);
+	Napi::Value del_range(const Napi::CallbackInfo&);
 	Napi::Value drop(const Napi::CallbackInfo&);
+	Napi::Value bloom_stats(const Napi::CallbackInfo&);
+	Napi::Value cache_stats(const Napi::CallbackInfo&);
 
 private:
     // Внутренний метод для forEach с начальным ключом
@@ -107,6 +124,10 @@ public:
         value_flag_ = value_flag;
     }
 
+    void attach_cache(std::size_t max_bytes) {
+        cache_ = max_bytes ? std::make_unique<value_cache>(max_bytes) : nullptr;
+    }
+
     operator MDBX_put_flags_t() const noexcept {
         return static_cast<MDBX_put_flags_t>(key_mode_.val & value_mode_.val);
     }
@@ -138,6 +159,32 @@ public:
     convmou get_convmou() const noexcept {
         return convmou::for_dbi(*this);
     }
+
+    // ключ по режиму базы: ordinal - в num, кортеж или строка - в buf
+    keymou make_key(const Napi::Env& env, const Napi::Value& arg0,
+        buffer_type& buf, std::uint64_t& num) const;
+
+    // значение по режиму базы, как в put(): object, ordinal - в num,
+    // строка - в buf, Buffer без копии
+    valuemou make_value(const Napi::Env& env, const Napi::Value& arg0,
+        buffer_type& buf, std::uint64_t& num) const;
+
+    // все значения ключа после позиционирования курсора операцией op
+    // (MDBX_SET_KEY по key, MDBX_FIRST_DUP - текущий ключ) страницами
+    // MDBX_GET_MULTIPLE/MDBX_NEXT_MULTIPLE в один типизированный массив:
+    // BigUint64Array для multiOrdinal, иначе Uint8Array из записей подряд;
+    // undefined если ключа нет
+    Napi::Value read_dups(const Napi::Env& env, MDBX_cursor* cursor,
+        MDBX_cursor_op op, keymou* key) const;
+
+    // приращение increment(): целый Number или BigInt в диапазоне int64
+    static std::int64_t parse_delta(const Napi::Env& env, const Napi::Value& arg0);
+
+    // значения putDups(): BigUint64Array отдается без копии,
+    // Uint32Array и массив Number/BigInt расширяются до 64 бит в mem
+    static std::pair<const std::uint64_t*, std::size_t> parse_dups(
+        const Napi::Env& env, const Napi::Value& arg0,
+        std::vector<std::uint64_t>& mem);
 };
 
 } // namespace mdbxmou
@@ -14,6 +14,13 @@ struct env_arg0 {
 	base_flag key_flag{};
 	base_flag value_flag{};
 	bool track_borrowed_views{true};
+	// журнал изменений: changelog::mode и DBI журнала после открытия
+	std::uint8_t changelog{};
+	MDBX_dbi changelog_dbi{};
+	// следующий seq журнала для пишущей транзакции changelog_txnid,
+	// меняется только внутри пишущей транзакции
+	mutable std::uint64_t changelog_txnid{};
+	mutable std::uint64_t changelog_seq{};
 };
 
 static inline const env_arg0* get_env_userctx(MDBX_env* env_ptr)
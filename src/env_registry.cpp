@@ -0,0 +1,131 @@
+#include "env_registry.hpp"
+#include "bloom_filter.hpp"
+#include "changelog.hpp"
+#include "envmou.hpp"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace mdbxmou {
+
+namespace {
+
+// открытие и закрытие идут под мьютексом: libmdbx не допускает двух
+// MDBX_env на один файл в процессе, даже на время переоткрытия
+std::mutex registry_mutex{};
+std::unordered_map<std::string, env_shared*> registry{};
+
+void close_env(MDBX_env* env) noexcept
+{
+    auto rc = mdbx_env_close(env);
+    if (rc != MDBX_SUCCESS) {
+        fprintf(stderr, "mdbx_env_close %s\n", mdbx_strerror(rc));
+    }
+}
+
+std::unique_ptr<env_shared> open_shared(const env_arg0& arg0, std::string key)
+{
+    auto env = envmou::create_and_open(arg0);
+
+    auto shared = std::make_unique<env_shared>();
+    shared->env = env;
+    shared->arg0 = arg0;
+    shared->requested = arg0.flag;
+    shared->key = std::move(key);
+
+    unsigned flags{};
+    auto rc = mdbx_env_get_flags(env, &flags);
+    if (rc != MDBX_SUCCESS) {
+        close_env(env);
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    shared->arg0.flag.val = static_cast<int>(flags);
+
+    rc = mdbx_env_set_userctx(env, &shared->arg0);
+    if (rc != MDBX_SUCCESS) {
+        close_env(env);
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+
+    if (arg0.changelog != changelog::off) {
+        try {
+            // только для чтения журнал не создается, пишут его другие
+            shared->arg0.changelog_dbi =
+                changelog::open(env, !(flags & MDBX_RDONLY));
+        } catch (...) {
+            close_env(env);
+            throw;
+        }
+    }
+
+    return shared;
+}
+
+void check_compatible(const env_shared& shared, const env_arg0& arg0)
+{
+    if (shared.requested.val != arg0.flag.val) {
+        throw std::runtime_error(
+            "already opened in this process with different flags");
+    }
+    if (arg0.max_dbi > shared.arg0.max_dbi) {
+        throw std::runtime_error(
+            "already opened in this process with a smaller maxDbi");
+    }
+    if ((arg0.changelog != changelog::off) &&
+        (arg0.changelog != shared.arg0.changelog)) {
+        throw std::runtime_error(
+            "already opened in this process with other changelog settings");
+    }
+}
+
+} // namespace
+
+std::string env_registry::canonical_key(const std::string& path)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    // каталог окружения может еще не существовать
+    auto p = fs::weakly_canonical(fs::absolute(fs::u8path(path), ec), ec);
+    if (ec) {
+        return path;
+    }
+    return p.u8string();
+}
+
+env_shared* env_registry::acquire(const env_arg0& arg0)
+{
+    auto key = canonical_key(arg0.path);
+
+    std::lock_guard<std::mutex> l(registry_mutex);
+    auto it = registry.find(key);
+    if (it != registry.end()) {
+        check_compatible(*it->second, arg0);
+        ++it->second->refs;
+        return it->second;
+    }
+
+    auto shared = open_shared(arg0, key);
+    shared->refs = 1;
+    auto* rc = shared.get();
+    registry.emplace(std::move(key), shared.release());
+    return rc;
+}
+
+void env_registry::release(env_shared* shared) noexcept
+{
+    if (!shared) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> l(registry_mutex);
+    if (--shared->refs > 0) {
+        return;
+    }
+    registry.erase(shared->key);
+    bloom_registry::forget(shared->env);
+    close_env(shared->env);
+    delete shared;
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "env_arg0.hpp"
+#include <string>
+
+namespace mdbxmou {
+
+// Окружение, общее для всех изолятов процесса (main и worker_threads).
+// Каждый envmou - фасад своего изолята со своими транзакциями и
+// блокировками, а MDBX_env открывается один раз на каноничный путь.
+struct env_shared final
+{
+    MDBX_env* env{};
+    // общая конфигурация, она же userctx окружения
+    env_arg0 arg0{};
+    // флаги, запрошенные первым открывшим (arg0.flag - фактические)
+    env_flag requested{};
+    std::string key{};
+    // число открытых фасадов, меняется под мьютексом реестра
+    std::size_t refs{};
+};
+
+class env_registry final
+{
+public:
+    // открыть окружение или подключиться к уже открытому в процессе;
+    // несовместимые параметры второго открытия - исключение
+    static env_shared* acquire(const env_arg0& arg0);
+
+    // последний release закрывает окружение
+    static void release(env_shared* shared) noexcept;
+
+    static std::string canonical_key(const std::string& path);
+};
+
+} // namespace mdbxmou
@@ -1,14 +1,20 @@
 #include "envmou.hpp"
 #include "addon_state.hpp"
+#include "changelog.hpp"
 #include "txnmou.hpp"
 #include "async/envmou_copy_to.hpp"
+#include "async/envmou_copy_stream.hpp"
 #include "async/envmou_query.hpp"
 #include "async/envmou_open.hpp"
 #include "async/envmou_keys.hpp"
+#include "async/envmou_stat.hpp"
+#include "async/envmou_del_range.hpp"
+#include "async/envmou_changes.hpp"
 #include "async/envmou_close.hpp"
 #if defined(MDBXMOU_TESTING)
 #include "debug_writer.hpp"
 #endif
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <exception>
@@ -82,11 +88,19 @@ void envmou::init(const char *class_name, Napi::Env env, Napi::Object exports)
         InstanceMethod("closeSync", &envmou::close_sync),
         InstanceMethod("copyTo", &envmou::copy_to),
         InstanceMethod("copyToSync", &envmou::copy_to_sync),
+        InstanceMethod("copyToFd", &envmou::copy_to_fd),
+        InstanceMethod("copyToStream", &envmou::copy_to_stream),
         InstanceMethod("version", &envmou::get_version),
+        InstanceMethod("_envFlags", &envmou::get_env_flags),
         InstanceMethod("startRead", &envmou::start_read),
         InstanceMethod("startWrite", &envmou::start_write),
         InstanceMethod("query", &envmou::query),
         InstanceMethod("keys", &envmou::keys),
+        InstanceMethod("stat", &envmou::stat),
+        InstanceMethod("delRange", &envmou::del_range),
+        InstanceMethod("readChanges", &envmou::read_changes),
+        InstanceMethod("trimChanges", &envmou::trim_changes),
+        InstanceMethod("watch", &envmou::watch),
         InstanceMethod("setOption", &envmou::set_option),
         InstanceMethod("syncEx", &envmou::sync_ex),
 #if defined(MDBXMOU_TESTING)
@@ -192,6 +206,22 @@ env_arg0 envmou::parse(const Napi::Value& arg0)
 		}
 	}
 
+	if (obj.Has("changelog")) {
+		// changelog: true - только ключи, { values: true } - ключи и значения
+		auto value = obj.Get("changelog");
+		if (value.IsBoolean()) {
+			rc.changelog = value.As<Napi::Boolean>().Value() ?
+				changelog::keys : changelog::off;
+		} else if (value.IsObject()) {
+			auto values = value.As<Napi::Object>().Get("values");
+			rc.changelog = values.ToBoolean().Value() ?
+				changelog::values : changelog::keys;
+		} else if (!value.IsUndefined()) {
+			throw Napi::TypeError::New(
+				obj.Env(), "changelog must be a boolean or { values?: boolean }");
+		}
+	}
+
 	return rc;
 }
 
@@ -235,7 +265,7 @@ Napi::Value envmou::open_sync(const Napi::CallbackInfo& info)
         if (is_open()) {
             throw std::runtime_error("already opened");
         }
-        attach(create_and_open(arg0), arg0);
+        attach(env_registry::acquire(arg0), arg0);
     } catch (const std::exception& e) {
         throw Napi::Error::New(env, e.what());
     }
@@ -281,25 +311,15 @@ MDBX_env* envmou::create_and_open(const env_arg0& arg0)
     return env;
 }
 
-void envmou::attach(MDBX_env* env, const env_arg0& arg0)
+void envmou::attach(env_shared* shared, const env_arg0& arg0)
 {
+	// флаги и журнал изменений общие, остальное - настройки фасада
 	arg0_ = arg0;
+	arg0_.flag = shared->arg0.flag;
+	arg0_.changelog = shared->arg0.changelog;
+	arg0_.changelog_dbi = shared->arg0.changelog_dbi;
 
-	unsigned flags{};
-	auto rc = mdbx_env_get_flags(env, &flags);
-	if (rc != MDBX_SUCCESS) {
-		mdbx_env_close(env);
-		throw std::runtime_error(mdbx_strerror(rc));
-	}
-	arg0_.flag.val = static_cast<int>(flags);
-
-	rc = mdbx_env_set_userctx(env, &arg0_);
-	if (rc != MDBX_SUCCESS) {
-		mdbx_env_close(env);
-		throw std::runtime_error(mdbx_strerror(rc));
-	}
-
-	env_.reset(env);
+	env_.reset(shared);
 }
 
 Napi::Value envmou::close(const Napi::CallbackInfo& info)
@@ -385,7 +405,33 @@ Napi::Value envmou::copy_to(const Napi::CallbackInfo& info)
     Napi::Env env = info.Env();
 
     if (info.Length() < 1 || !info[0].IsString()) {
-        throw Napi::TypeError::New(env, "copyTo(path: string[, flags?: number]) -> Promise<void>");
+        throw Napi::TypeError::New(env, "copyTo(path: string[, flags?: number | options]) -> Promise");
+    }
+
+    // copyTo(path, { compact, overwrite, maxBytesPerSec, onProgress })
+    if (info.Length() > 1 && info[1].IsObject()) {
+        try {
+            auto dest = info[0].As<Napi::String>().Utf8Value();
+            auto opt = parse_copy_options(info[1]);
+
+            lock_guard l(*this);
+
+            check();
+
+            auto* worker = new async_copy_paced(env, *this, 
+                std::move(dest), std::move(opt));
+            auto promise = worker->GetPromise();
+
+            // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+            ++(*this);
+            worker->Queue();
+
+            return promise;
+        } catch (const Napi::Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            throw Napi::Error::New(env, std::string("copyTo: ") + e.what());
+        }
     }
 
     MDBX_copy_flags_t flags{MDBX_CP_COMPACT};
@@ -413,6 +459,185 @@ Napi::Value envmou::copy_to(const Napi::CallbackInfo& info)
     return env.Undefined();
 }
 
+Napi::Value envmou::copy_to_fd(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    try {
+        auto fd = parse_copy_fd(info[0]);
+        auto opt = parse_copy_stream_options(info[1], "copyToFd");
+        if (opt.max_bytes_per_sec) {
+            throw Napi::RangeError::New(env, 
+                "copyToFd: maxBytesPerSec is only supported by copyToStream");
+        }
+
+        lock_guard l(*this);
+
+        check();
+
+        auto* worker = new async_copy_fd(env, *this, fd, opt.flags);
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("copyToFd: ") + e.what());
+    }
+}
+
+Napi::Value envmou::copy_to_stream(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (!info[0].IsObject() ||
+        !info[0].As<Napi::Object>().Get("write").IsFunction() ||
+        !info[0].As<Napi::Object>().Get("end").IsFunction()) {
+        throw Napi::TypeError::New(env, 
+            "copyToStream(writable: Writable[, options]) -> Promise");
+    }
+
+    try {
+        auto opt = parse_copy_stream_options(info[1], "copyToStream");
+
+        lock_guard l(*this);
+
+        check();
+
+        auto* worker = new async_copy_stream(env, *this, 
+            info[0].As<Napi::Object>(), opt);
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("copyToStream: ") + e.what());
+    }
+}
+
+Napi::Value envmou::read_changes(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    try {
+        auto query = parse_changes(info[0]);
+
+        lock_guard l(*this);
+
+        check();
+
+        auto conf = get_env_userctx(*this);
+        if (conf->changelog == changelog::off) {
+            throw std::runtime_error("changelog is not enabled");
+        }
+
+        auto* worker = new async_changes(env, *this, 
+            conf->changelog_dbi, query);
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("readChanges: ") + e.what());
+    }
+}
+
+Napi::Value envmou::trim_changes(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    try {
+        auto options = parse_trim_changes(info[0]);
+
+        lock_guard l(*this);
+
+        check();
+
+        auto conf = get_env_userctx(*this);
+        if (conf->changelog == changelog::off) {
+            throw std::runtime_error("changelog is not enabled");
+        }
+        if (conf->flag.val & MDBX_RDONLY) {
+            throw std::runtime_error("environment is read-only");
+        }
+
+        // журнал не пишет сам себя, delete_range удаляет без записей в нем
+        async_common common{};
+        common.id = conf->changelog_dbi;
+        auto* worker = new async_del_range(env, *this,
+            common, std::move(options));
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("trimChanges: ") + e.what());
+    }
+}
+
+Napi::Value envmou::watch(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (!info[0].IsFunction()) {
+        throw Napi::TypeError::New(env, 
+            "watch(callback: (txnId: number) => void[, { intervalMs }]) -> () => void");
+    }
+
+    auto max_interval = watchmou::default_max_interval;
+    if (info[1].IsObject()) {
+        auto value = info[1].As<Napi::Object>().Get("intervalMs");
+        if (!value.IsUndefined()) {
+            auto ms = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1.0;
+            if (!std::isfinite(ms) || ms < 1 || ms > 60000) {
+                throw Napi::RangeError::New(env, "watch: intervalMs must be in [1, 60000]");
+            }
+            max_interval = watchmou::duration{static_cast<std::int64_t>(ms)};
+        }
+    }
+
+    try {
+        lock_guard l(*this);
+
+        check();
+
+        auto watcher = std::make_shared<watchmou>(*this, max_interval);
+        watcher->start(env, info.This().As<Napi::Object>(), 
+            info[0].As<Napi::Function>());
+        {
+            std::lock_guard<std::mutex> wl(watch_lock_);
+            // остановленные через возвращенную функцию больше не нужны
+            watchers_.erase(std::remove_if(watchers_.begin(), watchers_.end(),
+                [](const auto& w) { return w->is_stopped(); }), watchers_.end());
+            watchers_.push_back(watcher);
+        }
+
+        return Napi::Function::New(env, 
+            [watcher](const Napi::CallbackInfo& info) {
+                watcher->stop();
+                return info.Env().Undefined();
+            }, "stopWatch");
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("watch: ") + e.what());
+    }
+}
+
 Napi::Value envmou::get_version(const Napi::CallbackInfo& info) 
 {
     std::string version = "mdbx v" + std::to_string(MDBX_VERSION_MAJOR);
@@ -420,6 +645,12 @@ Napi::Value envmou::get_version(const Napi::CallbackInfo& info)
     return Napi::Value::From(info.Env(), version);
 }
 
+Napi::Value envmou::get_env_flags(const Napi::CallbackInfo& info)
+{
+    return Napi::Number::New(info.Env(),
+        static_cast<double>(static_cast<unsigned>(arg0_.flag.val)));
+}
+
 Napi::Value envmou::start_transaction(
 	const Napi::CallbackInfo& info, txn_mode mode)
 {
@@ -536,6 +767,76 @@ Napi::Value envmou::keys(const Napi::CallbackInfo& info)
     return env.Undefined();
 }
 
+Napi::Value envmou::stat(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+
+    try
+    {
+        lock_guard lock(*this);
+
+        check();
+
+        auto query = parse_stat(info[0]);
+
+        auto* worker = new async_stat(env, *this, std::move(query));
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "envmou::stat");
+    }
+    return env.Undefined();
+}
+
+Napi::Value envmou::del_range(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject() ||
+        dbimou::is_instance(info[0])) {
+        throw Napi::TypeError::New(env,
+            "delRange: expected { dbi: MDBX_Dbi, start, end, limit, ... }");
+    }
+
+    try
+    {
+        lock_guard lock(*this);
+
+        check();
+
+        auto arg0 = info[0].As<Napi::Object>();
+        async_common common{};
+        auto* dbi = common.parse(arg0, "delRange");
+        auto options = parse_range_options(env, arg0, *dbi);
+
+        auto* worker = new async_del_range(env, *this,
+            common, std::move(options));
+        auto promise = worker->GetPromise();
+
+        // Увеличиваем счетчик ДО Queue() — worker гарантированно вызовет --env_
+        ++(*this);
+        worker->Queue();
+
+        return promise;
+    } catch (const Napi::Error&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw Napi::Error::New(env, std::string("delRange: ") + e.what());
+    } catch (...) {
+        throw Napi::Error::New(env, "envmou::del_range");
+    }
+    return env.Undefined();
+}
+
 Napi::Value envmou::set_option(const Napi::CallbackInfo &info)
 {
     Napi::Env env = info.Env();
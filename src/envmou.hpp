@@ -1,6 +1,8 @@
 #pragma once
 
 #include "txnmou.hpp"
+#include "watchmou.hpp"
+#include "env_registry.hpp"
 #include <cassert>
 #include <memory>
 #include <atomic>
@@ -26,21 +28,22 @@ class envmou final : public Napi::ObjectWrap<envmou>
 	static mdbx::env::geometry parse_geometry(const Napi::Value& obj);
 	static env_arg0 parse(const Napi::Value& obj);
 
-	struct free_env {
-		void operator()(MDBX_env* env) const
+	// окружение общее для процесса, фасад держит одну ссылку на него
+	struct release_env {
+		void operator()(env_shared* shared) const noexcept
 		{
-			auto rc = mdbx_env_close(env);
-			if (rc != MDBX_SUCCESS) {
-				fprintf(stderr, "mdbx_env_close %s\n", mdbx_strerror(rc));
-			}
+			env_registry::release(shared);
 		}
 	};
 
-	std::unique_ptr<MDBX_env, free_env> env_{};
+	std::unique_ptr<env_shared, release_env> env_{};
 	// счетчик транзакицй, не требующий атомарности
 	std::size_t trx_count_{};
 	env_arg0 arg0_{};
 	std::mutex lock_{};
+	// наблюдатели фиксаций, останавливаются при закрытии
+	std::mutex watch_lock_{};
+	std::vector<std::shared_ptr<watchmou>> watchers_{};
 
 #if defined(MDBXMOU_TESTING)
 	std::atomic<debug_writer_phase> debug_writer_phase_{
@@ -75,11 +78,18 @@ public:
 	}
 
 	static MDBX_env* create_and_open(const env_arg0& arg0);
-	void attach(MDBX_env* env, const env_arg0& arg0);
+	void attach(env_shared* shared, const env_arg0& arg0);
 
 	operator MDBX_env*() const noexcept
 	{
-		return env_.get();
+		return env_ ? env_->env : nullptr;
+	}
+
+	// настройки этого фасада (keyFlag, valueFlag и т.п.), userctx
+	// окружения общий для всех изолятов и их не содержит
+	const env_arg0& config() const noexcept
+	{
+		return arg0_;
 	}
 
 	static void init(
@@ -103,12 +113,27 @@ public:
 	Napi::Value close(const Napi::CallbackInfo&);
 	Napi::Value close_sync(const Napi::CallbackInfo&);
 	Napi::Value get_version(const Napi::CallbackInfo&);
+	// флаги открытия окружения (для env.snapshot в lib/nativemou.js)
+	Napi::Value get_env_flags(const Napi::CallbackInfo&);
 	Napi::Value copy_to_sync(const Napi::CallbackInfo&);
 	Napi::Value copy_to(const Napi::CallbackInfo&);
+	// потоковое копирование снимка через mdbx_env_copy2fd
+	Napi::Value copy_to_fd(const Napi::CallbackInfo&);
+	Napi::Value copy_to_stream(const Napi::CallbackInfo&);
 	// метод для групповых вставок или чтения
 	// внутри транзакция, получение db и чтение/запись
 	Napi::Value query(const Napi::CallbackInfo&);
 	Napi::Value keys(const Napi::CallbackInfo&);
+	// статистика окружения и выбранных dbi в фоновой читающей транзакции
+	Napi::Value stat(const Napi::CallbackInfo&);
+	// удаление диапазона ключей в фоновой пишущей транзакции
+	Napi::Value del_range(const Napi::CallbackInfo&);
+	// чтение журнала изменений (changelog) в фоновой читающей транзакции
+	Napi::Value read_changes(const Napi::CallbackInfo&);
+	// удаление записей журнала старше beforeTxnid в фоновой пишущей транзакции
+	Napi::Value trim_changes(const Napi::CallbackInfo&);
+	// уведомления о фиксациях, в том числе других процессов
+	Napi::Value watch(const Napi::CallbackInfo&);
 
 	Napi::Value set_option(const Napi::CallbackInfo&);
 	Napi::Value sync_ex(const Napi::CallbackInfo&);
@@ -153,11 +178,24 @@ public:
 		return locked;
 	}
 
+	void stop_watchers() noexcept
+	{
+		std::vector<std::shared_ptr<watchmou>> watchers;
+		{
+			std::lock_guard<std::mutex> l(watch_lock_);
+			watchers.swap(watchers_);
+		}
+		for (auto& w : watchers) {
+			w->stop();
+		}
+	}
+
 	void do_close()
 	{
 		if (trx_count_ > 0) {
 			throw std::runtime_error("transaction in progress");
 		}
+		stop_watchers();
 		env_.reset();
 	}
 };
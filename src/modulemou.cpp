@@ -91,6 +91,8 @@ Napi::Object Init(Napi::Env env, Napi::Object exports)
     Napi::Object keyMode = Napi::Object::New(env);
     MDBXMOU_DECLARE_FLAG_NAME(keyMode, "reverse", key_mode::reverse);
     MDBXMOU_DECLARE_FLAG_NAME(keyMode, "ordinal", key_mode::ordinal);
+    MDBXMOU_DECLARE_FLAG_NAME(keyMode, "int64", key_mode::int64);
+    MDBXMOU_DECLARE_FLAG_NAME(keyMode, "float64", key_mode::float64);
     mdbx_mou.Set("keyMode", keyMode);
 
     using mdbxmou::base_flag;
@@ -98,6 +100,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports)
     MDBXMOU_DECLARE_FLAG_NAME(key_flag, "string", base_flag::string);
     MDBXMOU_DECLARE_FLAG_NAME(key_flag, "number", base_flag::number);
     MDBXMOU_DECLARE_FLAG_NAME(key_flag, "bigint", base_flag::bigint);
+    MDBXMOU_DECLARE_FLAG_NAME(key_flag, "tuple", base_flag::tuple);
     mdbx_mou.Set("keyFlag", key_flag);
 
     using mdbxmou::value_mode;
@@ -114,6 +117,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports)
     MDBXMOU_DECLARE_FLAG_NAME(value_flag, "string", base_flag::string);
     MDBXMOU_DECLARE_FLAG_NAME(value_flag, "number", base_flag::number);
     MDBXMOU_DECLARE_FLAG_NAME(value_flag, "bigint", base_flag::bigint);
+    MDBXMOU_DECLARE_FLAG_NAME(value_flag, "object", base_flag::object);
     mdbx_mou.Set("valueFlag", value_flag);
 
     using mdbxmou::db_mode;
@@ -129,6 +133,9 @@ Napi::Object Init(Napi::Env env, Napi::Object exports)
     MDBXMOU_DECLARE_FLAG_NAME(queryMode, "insertUnique", query_mode::insert_unique);
     MDBXMOU_DECLARE_FLAG_NAME(queryMode, "get", query_mode::get);
     MDBXMOU_DECLARE_FLAG_NAME(queryMode, "del", query_mode::del);
+    MDBXMOU_DECLARE_FLAG_NAME(queryMode, "increment", query_mode::increment);
+    MDBXMOU_DECLARE_FLAG_NAME(queryMode, "compareAndSwap", query_mode::compare_swap);
+    MDBXMOU_DECLARE_FLAG_NAME(queryMode, "putDups", query_mode::put_dups);
     mdbx_mou.Set("queryMode", queryMode);
 
     using mdbxmou::put_flag;
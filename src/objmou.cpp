@@ -0,0 +1,585 @@
+#include "objmou.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace mdbxmou {
+
+namespace {
+
+constexpr std::int8_t timestamp_ext = -1;
+
+inline void check(napi_env env, napi_status status)
+{
+    if (status != napi_ok) {
+        throw Napi::Error::New(env);
+    }
+}
+
+class encoder final
+{
+    napi_env env_;
+    buffer_type& out_;
+
+    void put8(std::uint8_t v)
+    {
+        out_.push_back(static_cast<char>(v));
+    }
+
+    void put16(std::uint16_t v)
+    {
+        put8(static_cast<std::uint8_t>(v >> 8));
+        put8(static_cast<std::uint8_t>(v));
+    }
+
+    void put32(std::uint32_t v)
+    {
+        put16(static_cast<std::uint16_t>(v >> 16));
+        put16(static_cast<std::uint16_t>(v));
+    }
+
+    void put64(std::uint64_t v)
+    {
+        put32(static_cast<std::uint32_t>(v >> 32));
+        put32(static_cast<std::uint32_t>(v));
+    }
+
+    void put_bytes(const void* data, std::size_t size)
+    {
+        auto ptr = static_cast<const char*>(data);
+        out_.insert(out_.end(), ptr, ptr + size);
+    }
+
+    void put_uint(std::uint64_t v)
+    {
+        if (v < 0x80) {
+            put8(static_cast<std::uint8_t>(v));
+        } else if (v <= 0xff) {
+            put8(0xcc);
+            put8(static_cast<std::uint8_t>(v));
+        } else if (v <= 0xffff) {
+            put8(0xcd);
+            put16(static_cast<std::uint16_t>(v));
+        } else {
+            put8(0xce);
+            put32(static_cast<std::uint32_t>(v));
+        }
+    }
+
+    void put_int(std::int64_t v)
+    {
+        if (v >= 0) {
+            put_uint(static_cast<std::uint64_t>(v));
+        } else if (v >= -32) {
+            put8(static_cast<std::uint8_t>(v));
+        } else if (v >= std::numeric_limits<std::int8_t>::min()) {
+            put8(0xd0);
+            put8(static_cast<std::uint8_t>(v));
+        } else if (v >= std::numeric_limits<std::int16_t>::min()) {
+            put8(0xd1);
+            put16(static_cast<std::uint16_t>(v));
+        } else {
+            put8(0xd2);
+            put32(static_cast<std::uint32_t>(v));
+        }
+    }
+
+    void put_double(double v)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        put8(0xcb);
+        put64(bits);
+    }
+
+    void put_header(std::size_t size, std::uint8_t fix, std::uint8_t fix_limit,
+        std::uint8_t tag8, std::uint8_t tag16, std::uint8_t tag32)
+    {
+        if (size < fix_limit) {
+            put8(static_cast<std::uint8_t>(fix | size));
+        } else if (tag8 && size <= 0xff) {
+            put8(tag8);
+            put8(static_cast<std::uint8_t>(size));
+        } else if (size <= 0xffff) {
+            put8(tag16);
+            put16(static_cast<std::uint16_t>(size));
+        } else if (size <= 0xffffffffu) {
+            put8(tag32);
+            put32(static_cast<std::uint32_t>(size));
+        } else {
+            throw std::runtime_error("object: value too large");
+        }
+    }
+
+    void put_bin(const void* data, std::size_t size)
+    {
+        // у bin нет fix-формы
+        put_header(size, 0, 0, 0xc4, 0xc5, 0xc6);
+        put_bytes(data, size);
+    }
+
+    void put_number(napi_value v)
+    {
+        double d;
+        check(env_, napi_get_value_double(env_, v, &d));
+        if (std::trunc(d) == d && d >= -2147483648.0 && d <= 4294967295.0 &&
+            !(d == 0 && std::signbit(d))) {
+            put_int(static_cast<std::int64_t>(d));
+        } else {
+            put_double(d);
+        }
+    }
+
+    void put_bigint(napi_value v)
+    {
+        bool lossless;
+        std::int64_t i;
+        check(env_, napi_get_value_bigint_int64(env_, v, &i, &lossless));
+        if (lossless) {
+            put8(0xd3);
+            put64(static_cast<std::uint64_t>(i));
+            return;
+        }
+        std::uint64_t u;
+        check(env_, napi_get_value_bigint_uint64(env_, v, &u, &lossless));
+        if (!lossless) {
+            throw std::runtime_error("object: BigInt out of 64-bit range");
+        }
+        put8(0xcf);
+        put64(u);
+    }
+
+    void put_string(napi_value v)
+    {
+        std::size_t length;
+        check(env_, napi_get_value_string_utf8(env_, v, nullptr, 0, &length));
+        put_header(length, 0xa0, 32, 0xd9, 0xda, 0xdb);
+        // строка пишется сразу в выходной буфер, napi добавляет '\0'
+        auto pos = out_.size();
+        out_.resize(pos + length + 1);
+        check(env_, napi_get_value_string_utf8(env_, v,
+            out_.data() + pos, length + 1, nullptr));
+        out_.resize(pos + length);
+    }
+
+    void put_date(napi_value v)
+    {
+        double ms;
+        check(env_, napi_get_date_value(env_, v, &ms));
+        if (!std::isfinite(ms)) {
+            throw std::runtime_error("object: invalid Date");
+        }
+        auto sec = static_cast<std::int64_t>(std::floor(ms / 1000));
+        auto nsec = static_cast<std::uint32_t>(
+            std::llround((ms - static_cast<double>(sec) * 1000) * 1000000));
+        if (nsec >= 1000000000u) {
+            ++sec;
+            nsec -= 1000000000u;
+        }
+
+        if (sec >= 0 && (sec >> 34) == 0) {
+            if (nsec == 0 && (sec >> 32) == 0) {
+                put8(0xd6);
+                put8(static_cast<std::uint8_t>(timestamp_ext));
+                put32(static_cast<std::uint32_t>(sec));
+            } else {
+                put8(0xd7);
+                put8(static_cast<std::uint8_t>(timestamp_ext));
+                put64((static_cast<std::uint64_t>(nsec) << 34) |
+                    static_cast<std::uint64_t>(sec));
+            }
+        } else {
+            put8(0xc7);
+            put8(12);
+            put8(static_cast<std::uint8_t>(timestamp_ext));
+            put32(nsec);
+            put64(static_cast<std::uint64_t>(sec));
+        }
+    }
+
+    bool put_binary(napi_value v)
+    {
+        bool is;
+        check(env_, napi_is_typedarray(env_, v, &is));
+        if (is) {
+            napi_typedarray_type type;
+            std::size_t length;
+            void* data;
+            napi_value ab;
+            std::size_t offset;
+            check(env_, napi_get_typedarray_info(env_, v, &type, &length,
+                &data, &ab, &offset));
+            Napi::TypedArray ta{env_, v};
+            put_bin(data, length * ta.ElementSize());
+            return true;
+        }
+        check(env_, napi_is_dataview(env_, v, &is));
+        if (is) {
+            std::size_t length;
+            void* data;
+            napi_value ab;
+            std::size_t offset;
+            check(env_, napi_get_dataview_info(env_, v, &length, &data,
+                &ab, &offset));
+            put_bin(data, length);
+            return true;
+        }
+        check(env_, napi_is_arraybuffer(env_, v, &is));
+        if (is) {
+            void* data;
+            std::size_t length;
+            check(env_, napi_get_arraybuffer_info(env_, v, &data, &length));
+            put_bin(data, length);
+            return true;
+        }
+        return false;
+    }
+
+    void put_array(napi_value v, int depth)
+    {
+        std::uint32_t length;
+        check(env_, napi_get_array_length(env_, v, &length));
+        put_header(length, 0x90, 16, 0, 0xdc, 0xdd);
+        for (std::uint32_t i = 0; i < length; ++i) {
+            Napi::HandleScope scope{env_};
+            napi_value item;
+            check(env_, napi_get_element(env_, v, i, &item));
+            value(item, depth);
+        }
+    }
+
+    void put_map(napi_value v, int depth)
+    {
+        Napi::HandleScope scope{env_};
+        napi_value keys;
+        check(env_, napi_get_all_property_names(env_, v,
+            napi_key_own_only,
+            static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols),
+            napi_key_numbers_to_strings, &keys));
+        std::uint32_t length;
+        check(env_, napi_get_array_length(env_, keys, &length));
+
+        // undefined и функции пропускаются, как в JSON.stringify,
+        // поэтому число пар известно только после обхода
+        std::vector<std::pair<napi_value, napi_value>> props;
+        props.reserve(length);
+        for (std::uint32_t i = 0; i < length; ++i) {
+            napi_value key, item;
+            check(env_, napi_get_element(env_, keys, i, &key));
+            check(env_, napi_get_property(env_, v, key, &item));
+            napi_valuetype type;
+            check(env_, napi_typeof(env_, item, &type));
+            if (type == napi_undefined || type == napi_function) {
+                continue;
+            }
+            props.emplace_back(key, item);
+        }
+
+        put_header(props.size(), 0x80, 16, 0, 0xde, 0xdf);
+        for (auto& [key, item] : props) {
+            put_string(key);
+            value(item, depth);
+        }
+    }
+
+public:
+    encoder(napi_env env, buffer_type& out) noexcept
+        : env_{env}
+        , out_{out}
+    {   }
+
+    void value(napi_value v, int depth)
+    {
+        if (depth > objmou::max_depth) {
+            throw std::runtime_error("object: nesting too deep");
+        }
+
+        napi_valuetype type;
+        check(env_, napi_typeof(env_, v, &type));
+        switch (type) {
+        case napi_undefined:
+        case napi_null:
+            put8(0xc0);
+            return;
+        case napi_boolean: {
+            bool b;
+            check(env_, napi_get_value_bool(env_, v, &b));
+            put8(b ? 0xc3 : 0xc2);
+            return;
+        }
+        case napi_number:
+            put_number(v);
+            return;
+        case napi_bigint:
+            put_bigint(v);
+            return;
+        case napi_string:
+            put_string(v);
+            return;
+        case napi_object:
+            break;
+        default:
+            throw std::runtime_error("object: unsupported value type");
+        }
+
+        if (put_binary(v)) {
+            return;
+        }
+
+        bool is;
+        check(env_, napi_is_date(env_, v, &is));
+        if (is) {
+            put_date(v);
+            return;
+        }
+        check(env_, napi_is_array(env_, v, &is));
+        if (is) {
+            put_array(v, depth + 1);
+            return;
+        }
+        put_map(v, depth + 1);
+    }
+};
+
+class decoder final
+{
+    Napi::Env env_;
+    const std::uint8_t* ptr_;
+    const std::uint8_t* end_;
+
+    void need(std::size_t size) const
+    {
+        if (static_cast<std::size_t>(end_ - ptr_) < size) {
+            throw std::runtime_error("object: truncated value");
+        }
+    }
+
+    std::uint8_t get8()
+    {
+        need(1);
+        return *ptr_++;
+    }
+
+    std::uint16_t get16()
+    {
+        need(2);
+        std::uint16_t v = static_cast<std::uint16_t>((ptr_[0] << 8) | ptr_[1]);
+        ptr_ += 2;
+        return v;
+    }
+
+    std::uint32_t get32()
+    {
+        auto hi = get16();
+        return (static_cast<std::uint32_t>(hi) << 16) | get16();
+    }
+
+    std::uint64_t get64()
+    {
+        auto hi = get32();
+        return (static_cast<std::uint64_t>(hi) << 32) | get32();
+    }
+
+    const char* take(std::size_t size)
+    {
+        need(size);
+        auto p = reinterpret_cast<const char*>(ptr_);
+        ptr_ += size;
+        return p;
+    }
+
+    Napi::Value string(std::size_t size)
+    {
+        auto p = take(size);
+        return Napi::String::New(env_, p, size);
+    }
+
+    Napi::Value binary(std::size_t size)
+    {
+        auto p = take(size);
+        return Napi::Buffer<char>::Copy(env_, p, size);
+    }
+
+    Napi::Value array(std::size_t size, int depth)
+    {
+        auto arr = Napi::Array::New(env_, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            Napi::HandleScope scope{env_};
+            arr.Set(static_cast<std::uint32_t>(i), value(depth));
+        }
+        return arr;
+    }
+
+    Napi::Value map(std::size_t size, int depth)
+    {
+        auto obj = Napi::Object::New(env_);
+        for (std::size_t i = 0; i < size; ++i) {
+            Napi::HandleScope scope{env_};
+            auto key = value(depth);
+            if (!key.IsString()) {
+                // целые ключи других кодеров приводятся к строке
+                if (!key.IsNumber()) {
+                    throw std::runtime_error("object: unsupported map key");
+                }
+                key = key.ToString();
+            }
+            // Set с ключом "__proto__" из данных подменил бы прототип,
+            // поэтому свойство всегда определяется как собственное
+            auto item = value(depth);
+            obj.DefineProperty(Napi::PropertyDescriptor::Value(
+                key.As<Napi::Name>(), item, napi_default_jsproperty));
+        }
+        return obj;
+    }
+
+    Napi::Value ext(std::size_t size)
+    {
+        auto type = static_cast<std::int8_t>(get8());
+        if (type != timestamp_ext) {
+            throw std::runtime_error("object: unsupported extension type");
+        }
+
+        std::int64_t sec;
+        std::uint32_t nsec;
+        if (size == 4) {
+            sec = get32();
+            nsec = 0;
+        } else if (size == 8) {
+            auto v = get64();
+            nsec = static_cast<std::uint32_t>(v >> 34);
+            sec = static_cast<std::int64_t>(v & 0x3ffffffffull);
+        } else if (size == 12) {
+            nsec = get32();
+            sec = static_cast<std::int64_t>(get64());
+        } else {
+            throw std::runtime_error("object: invalid timestamp");
+        }
+        auto ms = static_cast<double>(sec) * 1000 +
+            static_cast<double>(nsec) / 1000000;
+        return Napi::Date::New(env_, ms);
+    }
+
+    Napi::Value int64(std::int64_t v)
+    {
+        return Napi::BigInt::New(env_, v);
+    }
+
+    Napi::Value uint64(std::uint64_t v)
+    {
+        return Napi::BigInt::New(env_, v);
+    }
+
+public:
+    decoder(const Napi::Env& env, const mdbx::slice& val) noexcept
+        : env_{env}
+        , ptr_{static_cast<const std::uint8_t*>(val.data())}
+        , end_{ptr_ + val.length()}
+    {   }
+
+    bool done() const noexcept
+    {
+        return ptr_ == end_;
+    }
+
+    Napi::Value value(int depth)
+    {
+        if (depth > objmou::max_depth) {
+            throw std::runtime_error("object: nesting too deep");
+        }
+
+        auto tag = get8();
+        if (tag < 0x80) {
+            return Napi::Number::New(env_, tag);
+        }
+        if (tag >= 0xe0) {
+            return Napi::Number::New(env_, static_cast<std::int8_t>(tag));
+        }
+        if ((tag & 0xf0) == 0x80) {
+            return map(tag & 0x0f, depth + 1);
+        }
+        if ((tag & 0xf0) == 0x90) {
+            return array(tag & 0x0f, depth + 1);
+        }
+        if ((tag & 0xe0) == 0xa0) {
+            return string(tag & 0x1f);
+        }
+
+        switch (tag) {
+        case 0xc0: return env_.Null();
+        case 0xc2: return Napi::Boolean::New(env_, false);
+        case 0xc3: return Napi::Boolean::New(env_, true);
+        case 0xc4: return binary(get8());
+        case 0xc5: return binary(get16());
+        case 0xc6: return binary(get32());
+        case 0xc7: {
+            auto size = get8();
+            return ext(size);
+        }
+        case 0xc8: {
+            auto size = get16();
+            return ext(size);
+        }
+        case 0xc9: {
+            auto size = get32();
+            return ext(size);
+        }
+        case 0xca: {
+            auto bits = get32();
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return Napi::Number::New(env_, f);
+        }
+        case 0xcb: {
+            auto bits = get64();
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return Napi::Number::New(env_, d);
+        }
+        case 0xcc: return Napi::Number::New(env_, get8());
+        case 0xcd: return Napi::Number::New(env_, get16());
+        case 0xce: return Napi::Number::New(env_, get32());
+        case 0xcf: return uint64(get64());
+        case 0xd0: return Napi::Number::New(env_, static_cast<std::int8_t>(get8()));
+        case 0xd1: return Napi::Number::New(env_, static_cast<std::int16_t>(get16()));
+        case 0xd2: return Napi::Number::New(env_, static_cast<std::int32_t>(get32()));
+        case 0xd3: return int64(static_cast<std::int64_t>(get64()));
+        case 0xd4: return ext(1);
+        case 0xd5: return ext(2);
+        case 0xd6: return ext(4);
+        case 0xd7: return ext(8);
+        case 0xd8: return ext(16);
+        case 0xd9: return string(get8());
+        case 0xda: return string(get16());
+        case 0xdb: return string(get32());
+        case 0xdc: return array(get16(), depth + 1);
+        case 0xdd: return array(get32(), depth + 1);
+        case 0xde: return map(get16(), depth + 1);
+        case 0xdf: return map(get32(), depth + 1);
+        default:
+            throw std::runtime_error("object: invalid MessagePack tag");
+        }
+    }
+};
+
+} // namespace
+
+valuemou objmou::encode(const Napi::Value& arg0, buffer_type& mem)
+{
+    mem.clear();
+    encoder{arg0.Env(), mem}.value(arg0, 0);
+    return {mem};
+}
+
+Napi::Value objmou::decode(const Napi::Env& env, const mdbx::slice& val)
+{
+    decoder d{env, val};
+    auto rc = d.value(0);
+    if (!d.done()) {
+        throw std::runtime_error("object: trailing bytes");
+    }
+    return rc;
+}
+
+} // namespace mdbxmou
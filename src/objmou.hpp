@@ -0,0 +1,26 @@
+#pragma once
+
+#include "valuemou.hpp"
+
+namespace mdbxmou {
+
+// Значения valueFlag.object: JS-значение кодируется в MessagePack прямо
+// из N-API, без JSON.stringify и промежуточной строки.
+//
+// number - fixint/int8..32/uint8..32 для целых в пределах 32 бит,
+// иначе float64; bigint - всегда int64/uint64, поэтому тип сохраняется.
+// Buffer, TypedArray, DataView, ArrayBuffer - bin (читается как Buffer),
+// Date - ext -1 (timestamp), undefined в объектах пропускается, в массивах
+// становится nil. Функции и символы не кодируются.
+struct objmou
+{
+    // защита от циклических ссылок
+    static constexpr int max_depth = 256;
+
+    // кодирует arg0 в mem и возвращает срез над mem
+    static valuemou encode(const Napi::Value& arg0, buffer_type& mem);
+
+    static Napi::Value decode(const Napi::Env& env, const mdbx::slice& val);
+};
+
+} // namespace mdbxmou
@@ -1,5 +1,7 @@
 #include "querymou.hpp"
 #include "dbimou.hpp"
+#include "objmou.hpp"
+#include "tuplemou.hpp"
 
 namespace mdbxmou {
 
@@ -20,24 +22,56 @@ void async_key::parse(const async_common& common, const Napi::Value& item)
 {
     keymou key{};
     if (mdbx::is_ordinal(common.key_mod)) {
-        key = keymou::from(item, item.Env(), id_buf);
+        key = keymou::from(item, item.Env(), id_buf, common.key_mod);
+    } else if (common.key_flag & base_flag::tuple) {
+        key = tuplemou::encode(item, key_buf);
     } else {
         key = keymou::from(item, item.Env(), key_buf);
     }
 }
 
+namespace {
+
+// копирует значение в buf/num: worker читает его после возврата в JS
+void parse_value(const query_line& common, const Napi::Value& item_val,
+    buffer_type& buf, std::uint64_t& num)
+{
+    valuemou val{};
+    val = is_ordinal(common.val_mod) ?
+        valuemou::from(item_val, item_val.Env(), num) :
+        (common.value_flag & base_flag::object) ?
+            objmou::encode(item_val, buf) :
+        (common.value_flag & base_flag::string) ?
+            valuemou{item_val.As<Napi::String>(), item_val.Env(), buf} :
+            valuemou{item_val.As<Napi::Buffer<char>>(), buf};
+}
+
+} // namespace
+
 void async_keyval::parse(const query_line& common, const Napi::Object& item)
 {
     async_key::parse(common, item);    
     // проверяем надо ли что-то писать
     if (common.mode.is_write()) {
-        valuemou val{};
-        auto item_val = item.Get("value");
-        val = is_ordinal(common.val_mod) ?
-            valuemou::from(item_val, item_val.Env(), val_num) :
-            (common.value_flag & base_flag::string) ?
-                valuemou{item_val.As<Napi::String>(), item_val.Env(), val_buf} :
-                valuemou{item_val.As<Napi::Buffer<char>>(), val_buf};
+        parse_value(common, item.Get("value"), val_buf, val_num);
+    } else if (common.mode.is_increment()) {
+        delta = dbimou::parse_delta(item.Env(), item.Get("delta"));
+    } else if (common.mode.is_compare_swap()) {
+        auto expected = item.Get("expected");
+        has_expected = !expected.IsUndefined();
+        if (has_expected) {
+            parse_value(common, expected, expected_buf, expected_num);
+        }
+        auto next = item.Get("value");
+        has_value = !next.IsUndefined();
+        if (has_value) {
+            parse_value(common, next, val_buf, val_num);
+        }
+    } else if (common.mode.is_put_dups()) {
+        auto values = dbimou::parse_dups(item.Env(), item.Get("value"), dups);
+        if (values.first != dups.data()) {
+            dups.assign(values.first, values.first + values.second);
+        }
     }
 }
 
@@ -46,11 +80,17 @@ void query_line::parse(txn_mode txn, const Napi::Object& arg0)
     //  парсим общие параметры
     auto dbi = async_common::parse(arg0, "query");
     value_flag = dbi->get_value_flag();
+    bloom = dbi->bloom();
     if (arg0.Has("mode")) {
         mode = query_mode::parse(txn, arg0.Get("mode").As<Napi::Number>());
     } else if (arg0.Has("queryMode")) {
         mode = query_mode::parse(txn, arg0.Get("queryMode").As<Napi::Number>());
     }
+    if (mode.is_put_dups() &&
+        (!is_ordinal(val_mod) || !(val_mod.val & MDBX_DUPFIXED))) {
+        throw Napi::TypeError::New(arg0.Env(),
+            "query putDups requires multiOrdinal valueMode");
+    }
     if (arg0.Has("putFlag")) {
         put_flags = put_flag::parse_query(arg0.Get("putFlag"));
         if (!mode.is_write()) {
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "bloom_filter.hpp"
 #include "valuemou.hpp"
 #include <mdbx.h++>
+#include <memory>
 
 namespace mdbxmou {
 
@@ -40,7 +42,18 @@ struct async_keyval
 {
     buffer_type val_buf{};
     std::uint64_t val_num{};
+    // del - найден ли ключ, compareAndSwap - выполнена ли замена
     bool found{false};
+    // increment: приращение и новое значение счетчика
+    std::int64_t delta{1};
+    std::int64_t counter{};
+    // compareAndSwap: expected и value, отсутствие - ключа нет / удалить
+    buffer_type expected_buf{};
+    std::uint64_t expected_num{};
+    bool has_expected{false};
+    bool has_value{false};
+    // putDups: значения ключа, всегда своя копия
+    std::vector<std::uint64_t> dups{};
 
     void parse(const query_line& line, const Napi::Object& obj);
 
@@ -59,6 +72,8 @@ struct query_line
     base_flag value_flag{};
     query_mode mode{};
     put_flag put_flags{};
+    // фильтр DBI для get, если открыт с bloom
+    std::shared_ptr<bloom_filter> bloom{};
     // буффер для запроса / ответа
     std::vector<async_keyval> item{};
     void parse(txn_mode txn, const Napi::Object& arg0);
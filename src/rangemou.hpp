@@ -0,0 +1,55 @@
+#pragma once
+
+#include "valuemou.hpp"
+#include <limits>
+
+namespace mdbxmou {
+
+class dbimou;
+
+// границы обхода getRange/getCount/delRange
+struct range_options final
+{
+    bool has_start{};
+    bool has_end{};
+    bool reverse{};
+    bool include_start{true};
+    bool include_end{true};
+    std::size_t limit{std::numeric_limits<std::size_t>::max()};
+    std::size_t offset{};
+    // Keep owning data only; bind keymou after range_options moves.
+    std::uint64_t start_num{};
+    std::uint64_t end_num{};
+    buffer_type start_buf{};
+    buffer_type end_buf{};
+    // prefix: только ключи, начинающиеся с prefix_buf;
+    // prefix_end - наименьший ключ после них, пуст если его нет
+    bool has_prefix{};
+    // keyFlag.tuple: после байтов префикса элемент может продолжаться
+    // (экранированный 0x00 строки, остаток BigInt) - со следующим байтом
+    // 0xff; такие ключи принадлежат другому кортежу
+    bool tuple_prefix{};
+    buffer_type prefix_buf{};
+    buffer_type prefix_end_buf{};
+
+    // ключ внутри prefix
+    bool prefix_match(const mdbx::slice& key) const noexcept
+    {
+        if (!key.starts_with(mdbx::slice{prefix_buf.data(), prefix_buf.size()})) {
+            return false;
+        }
+        return !tuple_prefix || key.size() == prefix_buf.size() ||
+            static_cast<std::uint8_t>(key.char_ptr()[prefix_buf.size()]) != 0xff;
+    }
+};
+
+range_options parse_range_options(const Napi::Env& env,
+    const Napi::Value& arg0, const dbimou& self);
+
+// удаляет ключи диапазона одним курсором (multi-value - со всеми
+// значениями), limit и offset считают ключи; возвращает число удаленных
+// ключей. Не использует Napi, вызывается и из фонового потока.
+std::size_t delete_range(MDBX_txn* txn, MDBX_dbi dbi, bool ordinal,
+    const range_options& options);
+
+} // namespace mdbxmou
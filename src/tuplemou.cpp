@@ -0,0 +1,363 @@
+#include "tuplemou.hpp"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace mdbxmou {
+
+namespace {
+
+enum code : std::uint8_t {
+    null_code = 0x00,
+    bytes_code = 0x01,
+    string_code = 0x02,
+    number_code = 0x21,
+    false_code = 0x26,
+    true_code = 0x27,
+    // остаток BigInt после числа; больше любого кода типа
+    rest_code = 0xff,
+};
+
+constexpr std::uint64_t sign_bit = 1ull << 63;
+
+// наибольшее целое, точно представимое в double
+constexpr std::uint64_t max_safe_integer = (1ull << 53) - 1;
+
+// 2^64 - граница BigInt, читаемых из ключа
+constexpr double two64 = 18446744073709551616.0;
+
+inline void check(napi_env env, napi_status status)
+{
+    if (status != napi_ok) {
+        throw Napi::Error::New(env);
+    }
+}
+
+inline std::size_t bit_length(std::uint64_t v) noexcept
+{
+    std::size_t n{};
+    while (v) {
+        ++n;
+        v >>= 1;
+    }
+    return n;
+}
+
+class encoder final
+{
+    napi_env env_;
+    buffer_type& out_;
+    buffer_type str_{};
+
+    void put8(std::uint8_t v)
+    {
+        out_.push_back(static_cast<char>(v));
+    }
+
+    void put_be(std::uint64_t v, std::size_t n)
+    {
+        while (n--) {
+            put8(static_cast<std::uint8_t>(v >> (n * 8)));
+        }
+    }
+
+    // байты с экранированием 0x00 и завершающим 0x00
+    void put_escaped(std::uint8_t type, const char* data, std::size_t size)
+    {
+        put8(type);
+        for (std::size_t i = 0; i < size; ++i) {
+            out_.push_back(data[i]);
+            if (data[i] == 0) {
+                put8(0xff);
+            }
+        }
+        put8(0x00);
+    }
+
+    // число: 8 байт double big-endian, у положительных инвертирован
+    // знаковый бит, у отрицательных все биты (как keyMode.float64)
+    void put_real(double d, std::uint64_t rest = 0)
+    {
+        // -0 и 0 - один ключ
+        if (d == 0) {
+            d = 0;
+        }
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        bits = (bits & sign_bit) ? ~bits : (bits ^ sign_bit);
+        put8(number_code);
+        put_be(bits, 8);
+        if (rest) {
+            put8(rest_code);
+            put_be(rest, 8);
+        }
+    }
+
+    void put_number(napi_value v)
+    {
+        double d;
+        check(env_, napi_get_value_double(env_, v, &d));
+        if (std::isnan(d)) {
+            throw std::runtime_error("tuple: NaN is not allowed");
+        }
+        put_real(d);
+    }
+
+    // BigInt, не представимый точно в double, пишется как ближайший
+    // снизу double и положительный остаток: такие ключи встают между
+    // соседними double, а равные Number и BigInt дают одну кодировку
+    void put_bigint(napi_value v)
+    {
+        int sign{};
+        std::size_t count{1};
+        std::uint64_t word{};
+        check(env_, napi_get_value_bigint_words(env_, v, &sign, &count, &word));
+        if (count > 1) {
+            throw std::runtime_error("tuple: BigInt out of 64-bit range");
+        }
+        auto bits = bit_length(word);
+        auto shift = (bits > 53) ? bits - 53 : 0;
+        auto low = word & ((1ull << shift) - 1);
+        auto high = static_cast<double>(word - low);
+        if (!sign) {
+            put_real(high, low);
+        } else if (!low) {
+            put_real(-high);
+        } else {
+            put_real(-(high + std::ldexp(1.0, static_cast<int>(shift))),
+                (1ull << shift) - low);
+        }
+    }
+
+    void put_string(napi_value v)
+    {
+        std::size_t length;
+        check(env_, napi_get_value_string_utf8(env_, v, nullptr, 0, &length));
+        str_.resize(length + 1);
+        check(env_, napi_get_value_string_utf8(env_, v,
+            str_.data(), str_.size(), nullptr));
+        put_escaped(string_code, str_.data(), length);
+    }
+
+    bool put_binary(napi_value v)
+    {
+        bool is;
+        check(env_, napi_is_typedarray(env_, v, &is));
+        if (is) {
+            napi_typedarray_type type;
+            std::size_t length;
+            void* data;
+            napi_value ab;
+            std::size_t offset;
+            check(env_, napi_get_typedarray_info(env_, v, &type, &length,
+                &data, &ab, &offset));
+            Napi::TypedArray ta{env_, v};
+            put_escaped(bytes_code, static_cast<const char*>(data),
+                length * ta.ElementSize());
+            return true;
+        }
+        check(env_, napi_is_arraybuffer(env_, v, &is));
+        if (is) {
+            void* data;
+            std::size_t length;
+            check(env_, napi_get_arraybuffer_info(env_, v, &data, &length));
+            put_escaped(bytes_code, static_cast<const char*>(data), length);
+            return true;
+        }
+        return false;
+    }
+
+    void element(napi_value v)
+    {
+        napi_valuetype type;
+        check(env_, napi_typeof(env_, v, &type));
+        switch (type) {
+        case napi_null:
+            put8(null_code);
+            return;
+        case napi_boolean: {
+            bool b;
+            check(env_, napi_get_value_bool(env_, v, &b));
+            put8(b ? true_code : false_code);
+            return;
+        }
+        case napi_number:
+            put_number(v);
+            return;
+        case napi_bigint:
+            put_bigint(v);
+            return;
+        case napi_string:
+            put_string(v);
+            return;
+        case napi_object:
+            if (put_binary(v)) {
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        throw std::runtime_error("tuple: unsupported element type");
+    }
+
+public:
+    encoder(napi_env env, buffer_type& out) noexcept
+        : env_{env}
+        , out_{out}
+    {   }
+
+    void tuple(napi_value v)
+    {
+        bool is;
+        check(env_, napi_is_array(env_, v, &is));
+        if (!is) {
+            throw std::runtime_error("tuple: key must be an Array");
+        }
+        std::uint32_t length;
+        check(env_, napi_get_array_length(env_, v, &length));
+        for (std::uint32_t i = 0; i < length; ++i) {
+            Napi::HandleScope scope{env_};
+            napi_value item;
+            check(env_, napi_get_element(env_, v, i, &item));
+            element(item);
+        }
+    }
+};
+
+class decoder final
+{
+    Napi::Env env_;
+    const std::uint8_t* ptr_;
+    const std::uint8_t* end_;
+    buffer_type tmp_{};
+
+    void need(std::size_t size) const
+    {
+        if (static_cast<std::size_t>(end_ - ptr_) < size) {
+            throw std::runtime_error("tuple: truncated key");
+        }
+    }
+
+    std::uint64_t get_be(std::size_t n)
+    {
+        need(n);
+        std::uint64_t v{};
+        while (n--) {
+            v = (v << 8) | *ptr_++;
+        }
+        return v;
+    }
+
+    // снимает экранирование до завершающего 0x00
+    const buffer_type& unescape()
+    {
+        tmp_.clear();
+        while (true) {
+            need(1);
+            auto c = *ptr_++;
+            if (c == 0x00) {
+                if (ptr_ != end_ && *ptr_ == 0xff) {
+                    ++ptr_;
+                } else {
+                    return tmp_;
+                }
+            }
+            tmp_.push_back(static_cast<char>(c));
+        }
+    }
+
+    Napi::Value bigint(bool negative, std::uint64_t magnitude)
+    {
+        napi_value rc;
+        check(env_, napi_create_bigint_words(env_, negative ? 1 : 0,
+            1, &magnitude, &rc));
+        return {env_, rc};
+    }
+
+    Napi::Value number()
+    {
+        auto bits = get_be(8);
+        bits = (bits & sign_bit) ? (bits ^ sign_bit) : ~bits;
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        auto a = std::fabs(d);
+        bool negative = d < 0;
+        if (ptr_ != end_ && *ptr_ == rest_code) {
+            ++ptr_;
+            auto rest = get_be(8);
+            if (std::trunc(d) != d || a > two64) {
+                throw std::runtime_error("tuple: invalid number");
+            }
+            // у отрицательных |d| бывает ровно 2^64, тогда вычитание
+            // из нуля по модулю 2^64 дает нужный модуль
+            auto base = (a < two64) ? static_cast<std::uint64_t>(a) : 0;
+            return bigint(negative, negative ? base - rest : base + rest);
+        }
+        // целые вне safe integer, но в пределах 64 бит - BigInt
+        if (std::trunc(d) == d && a > static_cast<double>(max_safe_integer) &&
+            a < two64) {
+            return bigint(negative, static_cast<std::uint64_t>(a));
+        }
+        return Napi::Number::New(env_, d);
+    }
+
+public:
+    decoder(const Napi::Env& env, const mdbx::slice& key) noexcept
+        : env_{env}
+        , ptr_{static_cast<const std::uint8_t*>(key.data())}
+        , end_{ptr_ + key.size()}
+    {   }
+
+    Napi::Value tuple()
+    {
+        auto arr = Napi::Array::New(env_);
+        std::uint32_t index{};
+        while (ptr_ != end_) {
+            Napi::HandleScope scope{env_};
+            arr.Set(index++, element());
+        }
+        return arr;
+    }
+
+    Napi::Value element()
+    {
+        auto type = *ptr_++;
+        switch (type) {
+        case null_code:
+            return env_.Null();
+        case bytes_code: {
+            auto& b = unescape();
+            return Napi::Buffer<char>::Copy(env_, b.data(), b.size());
+        }
+        case string_code: {
+            auto& s = unescape();
+            return Napi::String::New(env_, s.data(), s.size());
+        }
+        case number_code:
+            return number();
+        case false_code:
+            return Napi::Boolean::New(env_, false);
+        case true_code:
+            return Napi::Boolean::New(env_, true);
+        default:
+            throw std::runtime_error("tuple: unknown element type");
+        }
+    }
+};
+
+} // namespace
+
+keymou tuplemou::encode(const Napi::Value& arg0, buffer_type& mem)
+{
+    mem.clear();
+    encoder{arg0.Env(), mem}.tuple(arg0);
+    return {mem};
+}
+
+Napi::Value tuplemou::decode(const Napi::Env& env, const mdbx::slice& key)
+{
+    return decoder{env, key}.tuple();
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "valuemou.hpp"
+
+namespace mdbxmou {
+
+// Ключи keyFlag.tuple: массив JS-значений кодируется так, что побайтовое
+// сравнение (memcmp) совпадает с поэлементным сравнением кортежей.
+// Формат близок к кортежам FoundationDB, но все числа кодируются одним
+// типом, чтобы Number и BigInt шли в общем числовом порядке:
+//
+// 0x00 null
+// 0x01 Buffer/TypedArray/ArrayBuffer, 0x02 строка (utf8):
+//      байты 0x00 экранируются как 0x00 0xff, в конце 0x00
+// 0x21 число: double big-endian, у положительных инвертирован знаковый
+//      бит, у отрицательных все биты; -0 пишется как 0, NaN запрещен.
+//      BigInt, не представимый точно в double, пишется ближайшим снизу
+//      double, за которым идут 0xff и 8 байт остатка big-endian
+// 0x26 false, 0x27 true
+//
+// Числа при чтении возвращаются Number, а целые вне Number.isSafeInteger
+// в пределах 2^64 по модулю - BigInt.
+// Кодировка кортежа - байтовый префикс кодировки любого его продолжения,
+// поэтому короткий кортеж годится как префикс для getRange.
+struct tuplemou
+{
+    // кодирует массив arg0 в mem и возвращает срез над mem
+    static keymou encode(const Napi::Value& arg0, buffer_type& mem);
+
+    static Napi::Value decode(const Napi::Env& env, const mdbx::slice& key);
+};
+
+} // namespace mdbxmou
@@ -2,6 +2,7 @@
 #include "addon_state.hpp"
 #include "envmou.hpp"
 #include "cursormou.hpp"
+#include <cmath>
 #include <exception>
 #include <new>
 
@@ -48,7 +49,10 @@ txnmou* txnmou::unwrap_checked(
 		throw Napi::TypeError::New(env,
 			std::string(method_name) + ": argument must be MDBX_Txn instance");
 	}
-	return static_cast<txnmou*>(wrapper);
+	auto* txn = static_cast<txnmou*>(wrapper);
+	// все операции dbimou проходят здесь - отметка для автопарковки
+	txn->used_ = true;
+	return txn;
 }
 
 txnmou::~txnmou() noexcept
@@ -71,7 +75,12 @@ Napi::Function txnmou::init(const char* class_name, Napi::Env env)
 			InstanceMethod("openMap", &txnmou::open_map),
 			InstanceMethod("createMap", &txnmou::create_map),
 			InstanceMethod("openCursor", &txnmou::open_cursor),
+			InstanceMethod("execute", &txnmou::execute),
 			InstanceMethod("isActive", &txnmou::is_active_js),
+			InstanceMethod("park", &txnmou::park),
+			InstanceMethod("unpark", &txnmou::unpark),
+			InstanceMethod("isParked", &txnmou::is_parked_js),
+			InstanceMethod("_parkIfIdle", &txnmou::park_if_idle),
 #if defined(MDBXMOU_TESTING)
 			InstanceMethod("_debugIssueView", &txnmou::debug_issue_view),
 			InstanceMethod("_debugViewStats", &txnmou::debug_view_stats),
@@ -138,12 +147,18 @@ Napi::Value txnmou::commit_and_start_read(const Napi::CallbackInfo& info)
 		throw Napi::Error::New(env, "txn environment owner unavailable");
 	}
 
+	cursors_.clear();
 	// MDBXMOU-0006-COMMIT-READ: libmdbx may replace or clear this handle.
 	auto* native_txn = txn_.release();
+	auto* native_env = mdbx_txn_env(native_txn);
+	const auto txnid = mdbx_txn_id(native_txn);
 	const auto rc = mdbx_txn_commit_embark_read(&native_txn, nullptr);
 	if (native_txn) {
 		txn_.reset(native_txn);
 	}
+	if (rc == MDBX_SUCCESS) {
+		bloom_registry::committed(native_env, txnid);
+	}
 
 	if (rc == MDBX_SUCCESS && native_txn) {
 		mode_ = {txn_mode::ro};
@@ -186,6 +201,8 @@ Napi::Value txnmou::checkpoint(const Napi::CallbackInfo& info)
 		throw Napi::Error::New(env, "txn environment owner unavailable");
 	}
 
+	cursors_.clear();
+	const auto txnid = mdbx_txn_id(txn_.get());
 	int rc{MDBX_SUCCESS};
 #if defined(MDBXMOU_TESTING)
 	if (debug_finish_before_checkpoint_) {
@@ -215,6 +232,8 @@ Napi::Value txnmou::checkpoint(const Napi::CallbackInfo& info)
 		throw Napi::Error::New(env, message);
 	}
 
+	bloom_registry::committed(mdbx_txn_env(txn_.get()), txnid);
+
 	// MDBXMOU-0007-CHECKPOINT: preserve the native mdbx++ boolean contract.
 	return Napi::Boolean::New(env, rc == MDBX_RESULT_TRUE);
 }
@@ -272,7 +291,10 @@ int txnmou::complete_native(completion_kind kind, envmou& env) noexcept
 {
 	assert(txn_);
 
+	cursors_.clear();
 	auto* txn = txn_.release();
+	auto* native_env = mdbx_txn_env(txn);
+	const auto txnid = mdbx_txn_id(txn);
 	const auto rc = kind == completion_kind::commit ? mdbx_txn_commit(txn)
 													: mdbx_txn_abort(txn);
 
@@ -281,6 +303,11 @@ int txnmou::complete_native(completion_kind kind, envmou& env) noexcept
 		return rc;
 	}
 
+	if (kind == completion_kind::commit && rc == MDBX_SUCCESS &&
+		!is_readonly()) {
+		bloom_registry::committed(native_env, txnid);
+	}
+
 	release_environment(&env);
 	return rc;
 }
@@ -299,6 +326,7 @@ void txnmou::Finalize(Napi::Env env)
 	auto* owner = get_environment(env);
 	detach_issued_noexcept(env);
 
+	cursors_.clear();
 	if (txn_) {
 		auto* txn = txn_.release();
 		const auto rc = mdbx_txn_abort(txn);
@@ -331,6 +359,19 @@ Napi::Value txnmou::issue_borrowed_view(napi_env env, const mdbx::slice& value)
 	return issue_view(env, value, track_borrowed_views_);
 }
 
+Napi::Value txnmou::issue_reserved_view(napi_env env, const mdbx::slice& value)
+{
+	return issue_view(env, value, true);
+}
+
+void txnmou::before_write(napi_env env)
+{
+	// в пишущей транзакции getView запрещен, все виды - от reserve()
+	if (!is_readonly() && !issued_views_.empty()) {
+		detach_issued_or_throw(env);
+	}
+}
+
 void txnmou::track_view(
 	napi_env env, napi_value array_buffer, view_issue_fault fault)
 {
@@ -537,7 +578,9 @@ Napi::Value txnmou::get_dbi(const char* name,
 	key_mode key_mode,
 	value_mode value_mode,
 	db_mode db_mode,
-	int db_flags_override)
+	int db_flags_override,
+	unsigned bloom_bits,
+	std::size_t cache_bytes)
 {
 	Napi::Env env = Env();
 
@@ -554,7 +597,7 @@ Napi::Value txnmou::get_dbi(const char* name,
 	auto flags = db_flags_override >= 0
 		? static_cast<MDBX_db_flags_t>(db_flags_override)
 		: static_cast<MDBX_db_flags_t>(
-			  db_mode.val | key_mode.val | value_mode.val);
+			  db_mode.val | key_mode.db_flags() | value_mode.val);
 	auto rc =
 		mdbx_dbi_open(*this, (name && name[0]) ? name : nullptr, flags, &dbi);
 	if (rc != MDBX_SUCCESS) {
@@ -565,6 +608,12 @@ Napi::Value txnmou::get_dbi(const char* name,
 	auto obj = addon_state::get(env).new_dbi();
 	auto ptr = dbimou::Unwrap(obj);
 	ptr->attach(dbi, db_mode, key_mode, value_mode, key_flag, value_flag);
+	// фильтр общий для всех хендлов DBI в процессе
+	auto* native_env = mdbx_txn_env(*this);
+	ptr->attach_bloom(bloom_bits
+		? bloom_registry::enable(native_env, dbi, bloom_bits)
+		: bloom_registry::find(native_env, dbi));
+	ptr->attach_cache(cache_bytes);
 	return obj;
 }
 
@@ -580,7 +629,8 @@ Napi::Value txnmou::get_dbi(const Napi::Object& arg0, db_mode db_mode)
 		throw Napi::Error::New(env, "txn environment owner unavailable");
 	}
 
-	auto conf = get_env_userctx(*owner);
+	// настройки фасада, userctx окружения общий для всех изолятов
+	auto conf = &owner->config();
 	// параметры по умолчанию из окружения
 	auto key_flag = conf->key_flag;
 	auto value_flag = conf->value_flag;
@@ -588,6 +638,8 @@ Napi::Value txnmou::get_dbi(const Napi::Object& arg0, db_mode db_mode)
 	value_mode value_mode{};
 	std::string db_name{};
 	int db_flags_override = -1;
+	unsigned bloom_bits = 0;
+	std::size_t cache_bytes = 0;
 
 	if (arg0.Has("name")) {
 		auto value = arg0.Get("name");
@@ -642,13 +694,62 @@ Napi::Value txnmou::get_dbi(const Napi::Object& arg0, db_mode db_mode)
 		}
 	}
 
+	// bloom: true | { bitsPerKey }
+	if (arg0.Has("bloom")) {
+		auto value = arg0.Get("bloom");
+		if (value.IsBoolean()) {
+			bloom_bits = value.As<Napi::Boolean>().Value()
+				? bloom_filter::default_bits_per_key : 0;
+		} else if (value.IsObject()) {
+			bloom_bits = bloom_filter::default_bits_per_key;
+			auto bits = value.As<Napi::Object>().Get("bitsPerKey");
+			if (!bits.IsUndefined()) {
+				auto n = bits.IsNumber() ? bits.As<Napi::Number>().DoubleValue() : 0;
+				if (n < 1 || n > 32 || n != static_cast<unsigned>(n)) {
+					throw Napi::RangeError::New(env,
+						"dbi: bloom.bitsPerKey must be an integer in 1..32");
+				}
+				bloom_bits = static_cast<unsigned>(n);
+			}
+		} else if (!value.IsUndefined() && !value.IsNull()) {
+			throw Napi::TypeError::New(env,
+				"dbi: bloom must be boolean or object");
+		}
+	}
+
+	// cache: true | { maxBytes }
+	if (arg0.Has("cache")) {
+		auto value = arg0.Get("cache");
+		if (value.IsBoolean()) {
+			cache_bytes = value.As<Napi::Boolean>().Value()
+				? value_cache::default_max_bytes : 0;
+		} else if (value.IsObject()) {
+			cache_bytes = value_cache::default_max_bytes;
+			auto bytes = value.As<Napi::Object>().Get("maxBytes");
+			if (!bytes.IsUndefined()) {
+				auto n = bytes.IsNumber() ? bytes.As<Napi::Number>().DoubleValue() : 0;
+				if (!(n >= 1) || n > static_cast<double>(SIZE_MAX) ||
+					n != std::floor(n)) {
+					throw Napi::RangeError::New(env,
+						"dbi: cache.maxBytes must be a positive integer");
+				}
+				cache_bytes = static_cast<std::size_t>(n);
+			}
+		} else if (!value.IsUndefined() && !value.IsNull()) {
+			throw Napi::TypeError::New(env,
+				"dbi: cache must be boolean or object");
+		}
+	}
+
 	return get_dbi(db_name.empty() ? nullptr : db_name.c_str(),
 		key_flag,
 		value_flag,
 		key_mode,
 		value_mode,
 		db_mode,
-		db_flags_override);
+		db_flags_override,
+		bloom_bits,
+		cache_bytes);
 }
 
 Napi::Value txnmou::get_dbi(const Napi::CallbackInfo& info, db_mode db_mode)
@@ -664,7 +765,8 @@ Napi::Value txnmou::get_dbi(const Napi::CallbackInfo& info, db_mode db_mode)
 		throw Napi::Error::New(env, "txn environment owner unavailable");
 	}
 
-	auto conf = get_env_userctx(*owner);
+	// настройки фасада, userctx окружения общий для всех изолятов
+	auto conf = &owner->config();
 	auto key_flag = conf->key_flag;
 	auto value_flag = conf->value_flag;
 	key_mode key_mode{};
@@ -754,6 +856,106 @@ Napi::Value txnmou::is_active_js(const Napi::CallbackInfo& info)
 	return Napi::Boolean::New(info.Env(), is_active());
 }
 
+bool txnmou::is_parked() const noexcept
+{
+	return txn_ && (mdbx_txn_flags(txn_.get()) & MDBX_TXN_PARKED) != 0;
+}
+
+int txnmou::park_native(napi_env env, bool autounpark)
+{
+	// припаркованный снимок может быть вытеснен и его страницы переписаны:
+	// виды отсоединяются, как при abort
+	detach_issued_or_throw(env);
+	cursors_.clear();
+	used_ = false;
+	return mdbx_txn_park(txn_.get(), autounpark);
+}
+
+Napi::Value txnmou::park(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+
+	if (!is_active()) {
+		throw Napi::Error::New(env, "txn already completed");
+	}
+	if (!is_readonly()) {
+		throw Napi::TypeError::New(env, "txn park: read transaction required");
+	}
+
+	bool autounpark{};
+	if (info.Length() > 0 && info[0].IsObject()) {
+		auto autounpark_value = info[0].As<Napi::Object>().Get("autoUnpark");
+		if (!autounpark_value.IsUndefined()) {
+			autounpark = autounpark_value.ToBoolean().Value();
+		}
+	}
+
+	if (is_parked()) {
+		return env.Undefined();
+	}
+	const auto rc = park_native(env, autounpark);
+	if (rc != MDBX_SUCCESS) {
+		throw Napi::Error::New(
+			env, std::string("txn park: ") + mdbx_strerror(rc));
+	}
+	return env.Undefined();
+}
+
+Napi::Value txnmou::unpark(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+
+	if (!is_active()) {
+		throw Napi::Error::New(env, "txn already completed");
+	}
+
+	bool restart_if_ousted{};
+	if (info.Length() > 0 && info[0].IsObject()) {
+		auto restart_value =
+			info[0].As<Napi::Object>().Get("restartIfOusted");
+		if (!restart_value.IsUndefined()) {
+			restart_if_ousted = restart_value.ToBoolean().Value();
+		}
+	}
+
+	if (!is_parked()) {
+		return Napi::Boolean::New(env, false);
+	}
+	// MDBX_RESULT_TRUE - снимок был вытеснен и транзакция перезапущена
+	// на новом; без restartIfOusted это MDBX_OUSTED, транзакцию
+	// остается только прервать
+	const auto rc = mdbx_txn_unpark(txn_.get(), restart_if_ousted);
+	if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+		throw Napi::Error::New(
+			env, std::string("txn unpark: ") + mdbx_strerror(rc));
+	}
+	return Napi::Boolean::New(env, rc == MDBX_RESULT_TRUE);
+}
+
+Napi::Value txnmou::is_parked_js(const Napi::CallbackInfo& info)
+{
+	return Napi::Boolean::New(info.Env(), is_parked());
+}
+
+Napi::Value txnmou::park_if_idle(const Napi::CallbackInfo& info)
+{
+	Napi::Env env = info.Env();
+
+	// false - таймер автопарковки больше не нужен
+	if (!is_active() || !is_readonly()) {
+		return Napi::Boolean::New(env, false);
+	}
+	if (std::exchange(used_, false) || is_parked()) {
+		return Napi::Boolean::New(env, true);
+	}
+	// вызывается из таймера: ошибка означает только пропуск парковки
+	try {
+		(void)park_native(env, true);
+	} catch (const Napi::Error&) {
+	}
+	return Napi::Boolean::New(env, true);
+}
+
 #if defined(MDBXMOU_TESTING)
 bool txnmou::consume_detach_fault(detach_fault fault) noexcept
 {
@@ -825,9 +1027,8 @@ Napi::Value txnmou::debug_issue_view(const Napi::CallbackInfo& info)
 
 		buffer_type key_buffer{};
 		std::uint64_t key_number{};
-		const auto key = mdbx::is_ordinal(dbi_wrapper->get_key_mode())
-			? keymou::from(info[1], env, key_number)
-			: keymou::from(info[1], env, key_buffer);
+		const auto key =
+			dbi_wrapper->make_key(env, info[1], key_buffer, key_number);
 		const auto& raw_dbi = static_cast<const dbi&>(*dbi_wrapper);
 		const auto value = raw_dbi.get(txn_.get(), key);
 		if (value.is_null()) {
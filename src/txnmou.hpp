@@ -44,7 +44,11 @@ private:
 	txn_mode mode_{};
 	bool track_borrowed_views_{true};
 	bool writemap_{};
+	// было ли обращение с прошлой проверки автопарковки
+	bool used_{};
 	std::size_t cursor_count_{};
+	// курсоры внутренних обходов dbimou, закрываются до завершения txn
+	cursor_cache cursors_{};
 	std::vector<issued_view_ref> issued_views_{};
 	std::size_t next_prune_at_{initial_prune_threshold};
 
@@ -97,10 +101,14 @@ private:
 		key_mode key_mode,
 		value_mode value_mode,
 		db_mode db_mode,
-		int db_flags_override = -1);
+		int db_flags_override = -1,
+		unsigned bloom_bits = 0,
+		std::size_t cache_bytes = 0);
 	Napi::Value get_dbi(const Napi::Object& arg0, db_mode db_mode);
 	Napi::Value get_dbi(const Napi::CallbackInfo& info, db_mode db_mode);
 	Napi::Value is_active_js(const Napi::CallbackInfo& info);
+	Napi::Value is_parked_js(const Napi::CallbackInfo& info);
+	int park_native(napi_env env, bool autounpark);
 
 public:
 	static bool is_instance(const Napi::Value& value) noexcept;
@@ -138,6 +146,16 @@ public:
 
 	Napi::Value open_cursor(const Napi::CallbackInfo&);
 
+	// парковка читающей транзакции (mdbx_txn_park): снимок не держит
+	// сборку мусора, пока транзакция простаивает
+	Napi::Value park(const Napi::CallbackInfo&);
+	Napi::Value unpark(const Napi::CallbackInfo&);
+	// таймер автопарковки startRead({ autoParkMs }) из nativemou.js
+	Napi::Value park_if_idle(const Napi::CallbackInfo&);
+
+	// пакет get/put/del/has из буфера (batchmou.cpp)
+	Napi::Value execute(const Napi::CallbackInfo&);
+
 	operator MDBX_txn*() noexcept
 	{
 		return txn_.get();
@@ -161,6 +179,25 @@ public:
 		return cursor_count_;
 	}
 
+	// обращение через курсор - отметка для автопарковки, как в unwrap_checked
+	void mark_used() noexcept
+	{
+		used_ = true;
+	}
+
+	// курсор для обхода внутри одного вызова: берется из кэша транзакции
+	// и возвращается в него при разрушении
+	cursormou_managed cached_cursor(MDBX_dbi dbi)
+	{
+		return cursormou_managed{cursors_.take(txn_.get(), dbi), &cursors_};
+	}
+
+	// drop() удаляет DBI вместе с привязанными к нему курсорами
+	void close_cached_cursors() noexcept
+	{
+		cursors_.clear();
+	}
+
 	[[nodiscard]] bool is_active() const noexcept
 	{
 		return txn_ != nullptr;
@@ -171,12 +208,19 @@ public:
 		return (mode_.val & txn_mode::ro) != 0;
 	}
 
+	[[nodiscard]] bool is_parked() const noexcept;
+
 	[[nodiscard]] bool is_writemap() const noexcept
 	{
 		return writemap_;
 	}
 
 	Napi::Value issue_borrowed_view(napi_env env, const mdbx::slice& value);
+	// вид dbi.reserve() на грязную страницу, отслеживается всегда
+	Napi::Value issue_reserved_view(napi_env env, const mdbx::slice& value);
+	// следующая запись может сдвинуть грязные страницы: виды reserve()
+	// отсоединяются до нее, как при commit/abort
+	void before_write(napi_env env);
 
 	void attach(const Napi::Object& env_object,
 		MDBX_txn* txn,
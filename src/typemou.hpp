@@ -51,15 +51,88 @@ struct txnmou_managed final
     }
 };
 
+// Свободные курсоры одной транзакции: внутренние обходы (getRange, keys,
+// forEach, ...) берут курсор отсюда и возвращают его обратно вместо
+// mdbx_cursor_open/mdbx_cursor_close на каждый вызов. Курсор другого DBI
+// перепривязывается mdbx_cursor_bind без новой аллокации.
+class cursor_cache final
+{
+    std::vector<MDBX_cursor*> free_{};
+
+public:
+    static constexpr std::size_t limit{8};
+
+    cursor_cache() = default;
+    cursor_cache(const cursor_cache&) = delete;
+    cursor_cache& operator=(const cursor_cache&) = delete;
+
+    ~cursor_cache() noexcept
+    {
+        clear();
+    }
+
+    MDBX_cursor* take(MDBX_txn* txn, MDBX_dbi dbi)
+    {
+        for (auto i = free_.size(); i-- > 0; ) {
+            auto* cursor = free_[i];
+            if (::mdbx_cursor_txn(cursor) == txn &&
+                ::mdbx_cursor_dbi(cursor) == dbi) {
+                free_.erase(free_.begin() + static_cast<std::ptrdiff_t>(i));
+                return cursor;
+            }
+        }
+        if (!free_.empty()) {
+            auto* cursor = free_.back();
+            free_.pop_back();
+            auto rc = ::mdbx_cursor_bind(txn, cursor, dbi);
+            if (rc != MDBX_SUCCESS) {
+                ::mdbx_cursor_close(cursor);
+                mdbx::error::throw_exception(rc);
+            }
+            return cursor;
+        }
+        MDBX_cursor* cursor{};
+        mdbx::error::success_or_throw(::mdbx_cursor_open(txn, dbi, &cursor));
+        return cursor;
+    }
+
+    void give(MDBX_cursor* cursor) noexcept
+    {
+        if (free_.size() < limit) {
+            try {
+                free_.push_back(cursor);
+                return;
+            } catch (...) {
+            }
+        }
+        ::mdbx_cursor_close(cursor);
+    }
+
+    // до завершения транзакции: курсоры привязаны к ней
+    void clear() noexcept
+    {
+        for (auto* cursor : free_) {
+            ::mdbx_cursor_close(cursor);
+        }
+        free_.clear();
+    }
+};
+
 struct cursormou_managed final
     : mdbx::cursor
 {
-    explicit cursormou_managed(MDBX_cursor* cursor) noexcept
+    // cache - куда вернуть курсор вместо закрытия
+    cursor_cache* cache_{};
+
+    explicit cursormou_managed(MDBX_cursor* cursor,
+        cursor_cache* cache = nullptr) noexcept
         : mdbx::cursor(cursor)
+        , cache_{cache}
     {   }
 
     cursormou_managed(cursormou_managed &&other) noexcept
         : mdbx::cursor(std::exchange(other.cursor::handle_, nullptr))
+        , cache_{other.cache_}
     {   }
     
     cursormou_managed(const cursormou_managed&) = delete;
@@ -68,7 +141,11 @@ struct cursormou_managed final
     ~cursormou_managed() noexcept 
     {
         if (cursor::handle_) {
-            ::mdbx_cursor_close(cursor::handle_);
+            if (cache_) {
+                cache_->give(cursor::handle_);
+            } else {
+                ::mdbx_cursor_close(cursor::handle_);
+            }
         }
     }
 
@@ -163,11 +240,18 @@ struct query_mode
     enum type : int {
         get = 0x10000000,
         del = 0x20000000,
+        // item: { key, delta } - dbi.increment
+        increment = 0x04000000,
+        // item: { key, expected, value } - dbi.compareAndSwap
+        compare_swap = 0x08000000,
+        // item: { key, value: BigUint64Array | Uint32Array | Array } - dbi.putDups
+        put_dups = 0x02000000,
         upsert = MDBX_UPSERT,
         update = MDBX_CURRENT,
         insert_unique = MDBX_NOOVERWRITE,
         write_mask = upsert | update | insert_unique,
-        mask = get | del | upsert | update | insert_unique
+        op_mask = get | del | increment | compare_swap | put_dups,
+        mask = op_mask | write_mask
     };
     int val{get};
 
@@ -179,21 +263,31 @@ struct query_mode
         return (val & del) != 0;
     }
 
+    bool is_increment() const noexcept {
+        return (val & increment) != 0;
+    }
+
+    bool is_compare_swap() const noexcept {
+        return (val & compare_swap) != 0;
+    }
+
+    bool is_put_dups() const noexcept {
+        return (val & put_dups) != 0;
+    }
+
     bool is_write() const noexcept {
-        return !is_get() && !is_del();
+        return !(val & op_mask);
     }
 
     static inline query_mode parse(const txn_mode& mode, const Napi::Value& arg0) {
         query_mode rc{arg0.As<Napi::Number>().Int32Value() & mask};
-        if ((rc.is_get() || rc.is_del()) && (rc.val & write_mask)) {
+        auto op = rc.val & op_mask;
+        // не больше одной операции, режимы записи только без нее
+        if ((op & (op - 1)) || (op && (rc.val & write_mask))) {
             throw std::runtime_error(
-                "queryMode must be one of get/del/upsert/update/insertUnique");
+                "queryMode must be one of get/del/upsert/update/insertUnique/increment/compareAndSwap/putDups");
         }
-        if (rc.is_get() && rc.is_del()) {
-            throw std::runtime_error(
-                "queryMode must be one of get/del/upsert/update/insertUnique");
-        }
-        if ((mode.val & txn_mode::ro) && (rc.is_del() || rc.is_write())) {
+        if ((mode.val & txn_mode::ro) && !rc.is_get()) {
             throw std::runtime_error("rw query in read-only transaction");
         }
         return rc;
@@ -250,7 +344,14 @@ struct key_mode
     enum type : int {
         reverse = MDBX_REVERSEKEY,
         ordinal = MDBX_INTEGERKEY,
-        mask = MDBX_REVERSEKEY | MDBX_INTEGERKEY
+        // не флаги mdbx: ordinal-ключ хранит число со знаком,
+        // преобразованное так, что порядок u64 совпадает с порядком чисел
+        signed_key = 0x100000,
+        float_key = 0x200000,
+        int64 = MDBX_INTEGERKEY | signed_key,
+        float64 = MDBX_INTEGERKEY | float_key,
+        db_mask = MDBX_REVERSEKEY | MDBX_INTEGERKEY,
+        mask = db_mask | signed_key | float_key
     };
     int val{};
 
@@ -258,8 +359,13 @@ struct key_mode
         return {arg0.As<Napi::Number>().Int32Value() & mask};
     }
 
+    // флаги для mdbx_dbi_open, без собственных битов
+    int db_flags() const noexcept {
+        return val & db_mask;
+    }
+
     operator mdbx::key_mode() const noexcept {
-        return static_cast<mdbx::key_mode>(val & mask);
+        return static_cast<mdbx::key_mode>(val & db_mask);
     }
 };
 
@@ -296,8 +402,12 @@ struct base_flag
         string = 2,
         number = 4,
         bigint = 8,
-        mask_key = string | number | bigint,
-        mask_val = string | number | bigint
+        // значение - JS-объект в двоичном MessagePack (objmou)
+        object = 16,
+        // ключ - кортеж в порядке memcmp (tuplemou)
+        tuple = 32,
+        mask_key = string | number | bigint | tuple,
+        mask_val = string | number | bigint | object
     };
     int val{};
 
@@ -328,20 +438,20 @@ struct base_flag
 
     static inline void validate_key(const Napi::Value& arg0, int value) {
         if (value == 0 || value == string ||
-            value == number || value == bigint) {
+            value == number || value == bigint || value == tuple) {
             return;
         }
         throw Napi::Error::New(arg0.Env(),
-            "keyFlag must be 0, string, number or bigint");
+            "keyFlag must be 0, string, number, bigint or tuple");
     }
 
     static inline void validate_value(const Napi::Value& arg0, int value) {
         if (value == 0 || value == string ||
-            value == number || value == bigint) {
+            value == number || value == bigint || value == object) {
             return;
         }
         throw Napi::Error::New(arg0.Env(),
-            "valueFlag must be 0, string, number or bigint");
+            "valueFlag must be 0, string, number, bigint or object");
     }
 
     static inline base_flag parse_key(const Napi::Value& arg0) {
@@ -371,13 +481,14 @@ struct base_flag
 static inline key_mode parse_key_mode(Napi::Env env, const Napi::Value& arg0, base_flag& key_flag) 
 {
     key_mode mode{};
+    const bool tuple = key_flag & base_flag::tuple;
     if (arg0.IsBigInt()) {
         bool lossless;
         auto value = arg0.As<Napi::BigInt>().Int64Value(&lossless);
         if (!lossless) {
             throw Napi::Error::New(env, "BigInt value lossless conversion failed");
         }
-        mode.val = static_cast<int>(value);
+        mode.val = static_cast<int>(value) & key_mode::mask;
         if (mdbx::is_ordinal(mode)) {
             // только если цифровой key_flag не был задан
             if (!key_flag.is_numeric()) {
@@ -395,6 +506,21 @@ static inline key_mode parse_key_mode(Napi::Env env, const Napi::Value& arg0, ba
     } else {
         throw Napi::Error::New(env, "Invalid argument type for key mode");
     }
+    // кортежи упорядочены побайтово, ordinal и reverse их ломают
+    if (tuple && mode.val != 0) {
+        throw Napi::Error::New(env, "keyFlag.tuple requires the default keyMode");
+    }
+    auto numeric = mode.val & (key_mode::signed_key | key_mode::float_key);
+    if (numeric) {
+        if ((numeric != key_mode::signed_key && numeric != key_mode::float_key) ||
+            !mdbx::is_ordinal(mode)) {
+            throw Napi::Error::New(env, "keyMode must be one of int64 or float64");
+        }
+        // double не представить в BigInt без потерь
+        if (numeric == key_mode::float_key) {
+            key_flag = base_flag::number;
+        }
+    }
     return mode;
 }
 
@@ -0,0 +1,119 @@
+#include "value_cache.hpp"
+
+namespace mdbxmou {
+
+namespace {
+
+// учет узла списка, индекса и строк сверх самих байтов
+constexpr std::size_t entry_overhead = 96;
+
+// строки и числа JS не изменяемы, их можно отдавать повторно
+bool is_immutable(const convmou& conv) noexcept
+{
+    if (is_ordinal(conv.value_mode_)) {
+        return true;
+    }
+    return !(conv.value_flag_ & base_flag::object) &&
+        (conv.value_flag_ & base_flag::string);
+}
+
+} // namespace
+
+Napi::Value value_cache::get(const Napi::Env& env, const MDBX_txn* txn,
+    const dbi& db, const keymou& key, const convmou& conv)
+{
+    auto mod_txnid = db.get_stat(txn).ms_mod_txnid;
+    std::string_view k{key.char_ptr(), key.size()};
+
+    auto it = index_.find(k);
+    if (it != index_.end()) {
+        auto e = it->second;
+        if (e->mod_txnid == mod_txnid) {
+            ++hits_;
+            lru_.splice(lru_.begin(), lru_, e);
+            if (!e->found) {
+                return env.Undefined();
+            }
+            if (e->slot != no_slot) {
+                return slots_.Value().Get(e->slot);
+            }
+            return conv.convert_value(env,
+                mdbx::slice{e->value.data(), e->value.size()});
+        }
+        erase(e);
+    }
+
+    ++misses_;
+    auto val = db.get(txn, key);
+    if (val.is_null()) {
+        insert(env, k, mod_txnid, val, env.Undefined(), false);
+        return env.Undefined();
+    }
+    auto rc = conv.convert_value(env, val);
+    insert(env, k, mod_txnid, val, rc, is_immutable(conv));
+    return rc;
+}
+
+void value_cache::insert(const Napi::Env& env, std::string_view key,
+    std::uint64_t mod_txnid, const valuemou& val,
+    const Napi::Value& decoded, bool immutable)
+{
+    auto size = key.size() + val.size() + entry_overhead;
+    if (size > max_bytes_) {
+        return;
+    }
+
+    entry e{};
+    e.key.assign(key.data(), key.size());
+    e.mod_txnid = mod_txnid;
+    e.size = size;
+    e.found = !val.is_null();
+    if (e.found && immutable) {
+        if (slots_.IsEmpty()) {
+            slots_ = Napi::Persistent(Napi::Array::New(env));
+        }
+        if (free_slots_.empty()) {
+            e.slot = next_slot_++;
+        } else {
+            e.slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        slots_.Value().Set(e.slot, decoded);
+    } else if (e.found) {
+        e.value.assign(val.char_ptr(), val.size());
+    }
+
+    lru_.push_front(std::move(e));
+    auto& front = lru_.front();
+    index_.emplace(std::string_view{front.key}, lru_.begin());
+    bytes_ += size;
+
+    while (bytes_ > max_bytes_) {
+        erase(std::prev(lru_.end()));
+    }
+}
+
+void value_cache::erase(lru_type::iterator it)
+{
+    if (it->slot != no_slot) {
+        // массив не должен держать вытесненное значение
+        slots_.Value().Set(it->slot, slots_.Env().Undefined());
+        free_slots_.push_back(it->slot);
+    }
+    bytes_ -= it->size;
+    index_.erase(std::string_view{it->key});
+    lru_.erase(it);
+}
+
+value_cache::stats value_cache::get_stats() const noexcept
+{
+    stats rc{};
+    rc.hits = hits_;
+    rc.misses = misses_;
+    rc.entries = lru_.size();
+    rc.bytes = bytes_;
+    rc.max_bytes = max_bytes_;
+    return rc;
+}
+
+} // namespace mdbxmou
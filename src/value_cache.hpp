@@ -0,0 +1,83 @@
+#pragma once
+
+#include "convmou.hpp"
+#include "dbi.hpp"
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mdbxmou {
+
+// LRU-кэш значений одного хендла DBI (openMap({ cache })). Запись помнит
+// ms_mod_txnid DBI снимка, из которого прочитана, и годится для любого
+// снимка с тем же mod_txnid: фиксация в эту таблицу (в том числе другим
+// процессом) меняет mod_txnid и делает запись устаревшей. Пишущие транзакции
+// кэш обходят. Строки и числа хранятся уже декодированными в JS-массиве,
+// Buffer и объекты (изменяемые) декодируются заново из копии байтов.
+// Хендл живет в одном изоляте, блокировки не нужны.
+class value_cache final
+{
+public:
+    static constexpr std::size_t default_max_bytes = 1u << 20;
+
+    struct stats
+    {
+        std::uint64_t hits{};
+        std::uint64_t misses{};
+        std::size_t entries{};
+        std::size_t bytes{};
+        std::size_t max_bytes{};
+    };
+
+    explicit value_cache(std::size_t max_bytes) noexcept
+        : max_bytes_{max_bytes}
+    {   }
+
+    value_cache(const value_cache&) = delete;
+    value_cache& operator=(const value_cache&) = delete;
+
+    // значение key в снимке txn (undefined, если ключа нет)
+    Napi::Value get(const Napi::Env& env, const MDBX_txn* txn,
+        const dbi& db, const keymou& key, const convmou& conv);
+
+    stats get_stats() const noexcept;
+
+private:
+    static constexpr std::uint32_t no_slot = UINT32_MAX;
+
+    struct entry
+    {
+        std::string key{};
+        // байты значения, если оно не лежит декодированным в slots_
+        std::string value{};
+        std::uint64_t mod_txnid{};
+        std::size_t size{};
+        std::uint32_t slot{no_slot};
+        bool found{};
+    };
+
+    using lru_type = std::list<entry>;
+
+    void insert(const Napi::Env& env, std::string_view key,
+        std::uint64_t mod_txnid, const valuemou& val,
+        const Napi::Value& decoded, bool immutable);
+    void erase(lru_type::iterator it);
+
+    std::size_t max_bytes_{};
+    std::size_t bytes_{};
+    std::uint64_t hits_{};
+    std::uint64_t misses_{};
+
+    // голова - самая свежая запись
+    lru_type lru_{};
+    std::unordered_map<std::string_view, lru_type::iterator> index_{};
+
+    Napi::Reference<Napi::Array> slots_{};
+    std::vector<std::uint32_t> free_slots_{};
+    std::uint32_t next_slot_{};
+};
+
+} // namespace mdbxmou
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "typemou.hpp"
+#include <cmath>
+#include <cstring>
 
 namespace mdbxmou {
 
@@ -169,6 +171,75 @@ struct keymou final
         return {arg0.As<Napi::Number>(), env, mem};
     }
 
+    // keyMode.int64/float64: число со знаком хранится в u64 так,
+    // что беззнаковый порядок (MDBX_INTEGERKEY) совпадает с порядком чисел
+    static constexpr std::uint64_t sign_bit = 1ull << 63;
+
+    static inline keymou from(const Napi::Value& arg0,
+        const Napi::Env& env, std::uint64_t& mem, key_mode mode)
+    {
+        if (mode.val & key_mode::signed_key) {
+            std::int64_t value{};
+            if (arg0.IsBigInt()) {
+                bool lossless;
+                value = arg0.As<Napi::BigInt>().Int64Value(&lossless);
+                if (!lossless) {
+                    throw Napi::Error::New(env, "key out of int64 range");
+                }
+            } else if (arg0.IsNumber()) {
+                auto d = arg0.As<Napi::Number>().DoubleValue();
+                if (std::trunc(d) != d || d < -9223372036854775808.0 ||
+                    d >= 9223372036854775808.0) {
+                    throw Napi::Error::New(env, "key must be an int64 integer");
+                }
+                value = static_cast<std::int64_t>(d);
+            } else {
+                throw Napi::Error::New(env, "key must be a Number or BigInt");
+            }
+            mem = static_cast<std::uint64_t>(value) ^ sign_bit;
+            return {mem};
+        }
+
+        if (mode.val & key_mode::float_key) {
+            if (!arg0.IsNumber()) {
+                throw Napi::Error::New(env, "key must be a Number");
+            }
+            auto d = arg0.As<Napi::Number>().DoubleValue();
+            if (std::isnan(d)) {
+                throw Napi::Error::New(env, "key must not be NaN");
+            }
+            // -0 и 0 - один ключ
+            if (d == 0) {
+                d = 0;
+            }
+            std::uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            mem = (bits & sign_bit) ? ~bits : (bits ^ sign_bit);
+            return {mem};
+        }
+
+        return from(arg0, env, mem);
+    }
+
+    Napi::Value to_ordinal(const Napi::Env& env, key_mode mode, bool bigint) const
+    {
+        auto bits = as_uint64();
+        if (mode.val & key_mode::signed_key) {
+            auto value = static_cast<std::int64_t>(bits ^ sign_bit);
+            if (bigint) {
+                return Napi::BigInt::New(env, value);
+            }
+            return Napi::Number::New(env, static_cast<double>(value));
+        }
+        if (mode.val & key_mode::float_key) {
+            bits = (bits & sign_bit) ? (bits ^ sign_bit) : ~bits;
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return Napi::Number::New(env, d);
+        }
+        return bigint ? to_bigint(env) : to_number(env);
+    }
+
     static inline keymou from(const Napi::Value& arg0, 
         const Napi::Env& env, buffer_type& buf, std::uint64_t& num)
     {
@@ -0,0 +1,122 @@
+#include "watchmou.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mdbxmou {
+
+namespace {
+
+std::uint64_t recent_txnid(MDBX_env* env)
+{
+    MDBX_envinfo info{};
+    auto rc = mdbx_env_info_ex(env, nullptr, &info, sizeof(info));
+    if (rc != MDBX_SUCCESS) {
+        throw std::runtime_error(mdbx_strerror(rc));
+    }
+    return info.mi_recent_txnid;
+}
+
+} // namespace
+
+watchmou::~watchmou()
+{
+    stop();
+}
+
+void watchmou::start(Napi::Env env, Napi::Object env_object,
+    Napi::Function callback)
+{
+    last_txnid_ = recent_txnid(env_);
+    latest_ = last_txnid_;
+
+    auto* env_ref = new Napi::ObjectReference{Napi::Persistent(env_object)};
+    tsfn_ = Napi::ThreadSafeFunction::New(env, callback, "mdbxmou.watch",
+        0, 1, [](Napi::Env, Napi::ObjectReference* ref) {
+            delete ref;
+        }, env_ref);
+
+    // поток владеет наблюдателем, пока не завершится
+    thread_ = std::thread{[self = shared_from_this()] { self->run(); }};
+}
+
+void watchmou::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (stop_requested_) {
+            return;
+        }
+        stop_requested_ = true;
+    }
+    stopped_ = true;
+    cv_.notify_all();
+
+    if (thread_.joinable()) {
+        // последняя ссылка уходит в самом потоке, когда он завершается
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+    if (tsfn_) {
+        tsfn_.Release();
+    }
+}
+
+void watchmou::notify(std::uint64_t txnid) noexcept
+{
+    latest_ = txnid;
+    if (pending_.exchange(true)) {
+        return;
+    }
+
+    // уведомление держит наблюдателя живым до вызова в JS
+    auto self = shared_from_this();
+    auto status = tsfn_.NonBlockingCall(
+        [self](Napi::Env env, Napi::Function callback) {
+            self->pending_ = false;
+            if (!env || self->is_stopped()) {
+                return;
+            }
+            try {
+                callback.Call({Napi::Number::New(env,
+                    static_cast<double>(self->latest_.load()))});
+            } catch (const Napi::Error& e) {
+                // как у любого асинхронного колбэка - в uncaughtException
+                napi_fatal_exception(env, e.Value());
+            }
+        });
+    if (status != napi_ok) {
+        pending_ = false;
+    }
+}
+
+void watchmou::run() noexcept
+{
+    auto interval = min_interval;
+    std::unique_lock<std::mutex> l(mutex_);
+    while (!stop_requested_) {
+        if (cv_.wait_for(l, interval, [this] { return stop_requested_; })) {
+            break;
+        }
+
+        std::uint64_t txnid{};
+        try {
+            txnid = recent_txnid(env_);
+        } catch (const std::exception&) {
+            // окружение закрыто или повреждено - наблюдать нечего
+            break;
+        }
+
+        if (txnid != last_txnid_) {
+            last_txnid_ = txnid;
+            notify(txnid);
+            interval = min_interval;
+        } else {
+            interval = std::min(interval * 2, max_interval_);
+        }
+    }
+}
+
+} // namespace mdbxmou
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <napi.h>
+#include <mdbx.h++>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mdbxmou {
+
+// Наблюдение за фиксациями: поток опрашивает mi_recent_txnid через
+// mdbx_env_info_ex() (мета-страницы, без слота читателя) и сообщает
+// в JS через thread-safe function, когда txnid растет. Фиксации других
+// процессов видны так же, как свои.
+class watchmou final
+    : public std::enable_shared_from_this<watchmou>
+{
+public:
+    using duration = std::chrono::milliseconds;
+
+    // после изменения опрос идет с min, в простое интервал удваивается до max
+    static constexpr duration min_interval{1};
+    static constexpr duration default_max_interval{50};
+
+    watchmou(MDBX_env* env, duration max_interval) noexcept
+        : env_{env}
+        , max_interval_{max_interval}
+    {   }
+
+    ~watchmou();
+
+    // env_object удерживается до финализации thread-safe function,
+    // чтобы окружение не было собрано GC под работающим потоком
+    void start(Napi::Env env, Napi::Object env_object, Napi::Function callback);
+
+    // идемпотентно, нельзя вызывать из самого потока наблюдения
+    void stop() noexcept;
+
+    bool is_stopped() const noexcept {
+        return stopped_.load();
+    }
+
+private:
+    void run() noexcept;
+    void notify(std::uint64_t txnid) noexcept;
+
+    MDBX_env* env_{};
+    duration max_interval_{default_max_interval};
+    std::uint64_t last_txnid_{};
+
+    std::mutex mutex_{};
+    std::condition_variable cv_{};
+    bool stop_requested_{false};
+    std::atomic<bool> stopped_{false};
+    std::thread thread_{};
+
+    // уведомления схлопываются: в очереди не больше одного
+    std::atomic<std::uint64_t> latest_{};
+    std::atomic<bool> pending_{false};
+    Napi::ThreadSafeFunction tsfn_{};
+};
+
+} // namespace mdbxmou
@@ -0,0 +1,86 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Async_Env } = require("../lib/mdbx_evn_async.js");
+
+const keyCount = 500;
+
+async function readAll(env) {
+    const txn = await env.startRead();
+    const dbi = await txn.openMap();
+    const values = await dbi.getBatch(
+        Array.from({ length: keyCount }, (_, i) => `key-${i}`));
+    await txn.abort();
+    return values.filter((item) => item.found).length;
+}
+
+async function run(transport) {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-async-readers-"));
+    const env = new MDBX_Async_Env({ readers: 3, transport });
+    try {
+        await env.open({ path: dir });
+        assert.equal(env.readers.length, 3);
+
+        const txn = await env.startWrite();
+        const dbi = await txn.openMap({ create: true });
+        await dbi.putBatch(Array.from({ length: keyCount },
+            (_, i) => ({ key: `key-${i}`, value: `value-${i}` })));
+        await txn.commit();
+
+        // открытые одновременно читающие транзакции расходятся по воркерам
+        const open = await Promise.all([0, 1, 2].map(() => env.startRead()));
+        const workers = new Set(open.map((t) => t._channel));
+        assert.equal(workers.size, 3);
+        assert.ok(!workers.has(env.worker));
+        for (const t of open) {
+            const readDbi = await t.openMap();
+            assert.equal(await readDbi.get("key-42"), "value-42");
+        }
+        await Promise.all(open.map((t) => t.abort()));
+
+        // упакованный ответ: значения - Buffer поверх переданного ArrayBuffer
+        const iterTxn = await env.startRead();
+        const iterDbi = await iterTxn.openMap();
+        let seen = 0;
+        await iterDbi.forEach((key, value) => {
+            assert.ok(Buffer.isBuffer(value));
+            assert.equal(value.toString(), `value-${String(key).slice(4)}`);
+            seen++;
+        });
+        assert.equal(seen, keyCount);
+        await iterTxn.abort();
+
+        const counts = await Promise.all(
+            Array.from({ length: 12 }, () => readAll(env)));
+        assert.deepEqual(counts, new Array(12).fill(keyCount));
+
+        // запись по-прежнему одна и видна читателям
+        const next = await env.startWrite();
+        assert.equal(next._channel, env.worker);
+        const nextDbi = await next.openMap();
+        await nextDbi.put("key-0", "changed");
+        await next.commit();
+        const check = await env.startRead();
+        assert.equal(await (await check.openMap()).get("key-0"), "changed");
+        await check.abort();
+    } finally {
+        await env.terminate();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+async function main() {
+    await run("message");
+    await run("ring");
+    assert.throws(() => new MDBX_Async_Env({ readers: -1 }), RangeError);
+}
+
+main().then(() => {
+    console.log("async-readers test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
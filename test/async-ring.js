@@ -0,0 +1,107 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Async_Env } = require("../lib/mdbx_evn_async.js");
+const { Ring, encode, decode } = require("../lib/ring.js");
+
+function codecRoundTrip() {
+    const value = {
+        id: 7,
+        cmd: "dbi_put",
+        params: {
+            key: "ключ",
+            value: Buffer.from([0, 1, 2, 255]),
+            big: -(2n ** 70n),
+            float: 1.5,
+            wide: 2 ** 40,
+            list: [null, undefined, true, false],
+        },
+    };
+    const out = decode(Buffer.from(encode(value)));
+    assert.equal(out.params.key, value.params.key);
+    assert.deepEqual([...out.params.value], [...value.params.value]);
+    assert.equal(out.params.big, value.params.big);
+    assert.equal(out.params.float, 1.5);
+    assert.equal(out.params.wide, 2 ** 40);
+    assert.deepEqual(out.params.list, value.params.list);
+}
+
+function ringWrapAround() {
+    const ring = Ring.create(4096);
+    const payload = Buffer.alloc(1000, 0xab);
+    // кадры проходят через границу кольца много раз
+    for (let i = 0; i < 100; i++) {
+        payload[0] = i;
+        assert.equal(ring.tryWrite(payload), true);
+        const frame = ring.read();
+        assert.equal(frame.length, payload.length);
+        assert.equal(frame[0], i);
+        assert.equal(frame[999], 0xab);
+    }
+    assert.equal(ring.read(), null);
+    // заполненное кольцо не принимает кадр
+    let written = 0;
+    while (ring.tryWrite(payload)) {
+        written++;
+    }
+    assert.equal(written, 4);
+}
+
+async function main() {
+    codecRoundTrip();
+    ringWrapAround();
+
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-async-ring-"));
+    const env = new MDBX_Async_Env({ transport: "ring", ringSize: 4096 });
+    try {
+        await env.open({ path: dir });
+
+        const txn = await env.startWrite();
+        const dbi = await txn.openMap({ create: true });
+        // больше запросов, чем помещается в кольцо за раз
+        await Promise.all(Array.from({ length: 2000 },
+            (_, i) => dbi.put(`key-${i}`, `value-${i}`)));
+        // значение больше кольца уходит через MessagePort
+        const large = "x".repeat(10_000);
+        await dbi.put("large", large);
+        await txn.commit();
+
+        const readTxn = await env.startRead();
+        const readDbi = await readTxn.openMap();
+        assert.equal(await readDbi.get("key-1999"), "value-1999");
+        assert.equal(await readDbi.get("large"), large);
+        const batch = await readDbi.getBatch(["key-0", "missing"]);
+        assert.deepEqual(batch.map((item) => item.found), [true, false]);
+        assert.deepEqual(batch[0], { key: "key-0", value: "value-0", found: true });
+        const lazy = await readDbi.getBatch(["key-1", "large", "missing"], { lazy: true });
+        assert.deepEqual(lazy.map((item) => item.found), [true, true, false]);
+        assert.equal(lazy[1].value, large);
+        assert.equal(lazy[1].value, lazy[1].value);
+        assert.equal(lazy[2].value, null);
+        assert.deepEqual(JSON.parse(JSON.stringify(lazy[0])),
+            { key: "key-1", value: "value-1", found: true });
+        assert.equal((await readDbi.stat()).entries, 2001);
+        await readTxn.abort();
+
+        // ошибки воркера возвращаются через кольцо ответов
+        const probe = await env.startRead();
+        await assert.rejects(() => probe._call("nope"), /unknown cmd/);
+        await probe.abort();
+    } finally {
+        await env.terminate();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+
+    assert.throws(() => new MDBX_Async_Env({ transport: "pipe" }), TypeError);
+    assert.throws(() => Ring.create(5000), RangeError);
+}
+
+main().then(() => {
+    console.log("async-ring test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
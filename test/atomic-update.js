@@ -0,0 +1,96 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueFlag, valueMode, queryMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-atomic-update-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const counters = txn.createMap({ name: "counters", keyFlag: keyFlag.string });
+        const names = txn.createMap({
+            name: "names", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+        });
+        const dups = txn.createMap({
+            name: "dups", keyMode: keyMode.ordinal, valueMode: valueMode.multiOrdinal,
+        });
+
+        assert.equal(counters.increment(txn, "hits"), 1);
+        assert.equal(counters.increment(txn, "hits", 41), 42);
+        assert.equal(counters.increment(txn, "hits", -2), 40);
+        assert.equal(counters.increment(txn, "hits", 0), 40);
+        assert.equal(counters.increment(txn, "hits", 1n), 41n);
+        assert.equal(counters.get(txn, "hits").readBigInt64LE(0), 41n);
+        // чтение отсутствующего счетчика его не создает
+        assert.equal(counters.increment(txn, "none", 0), 0);
+        assert.equal(counters.has(txn, "none"), false);
+
+        counters.increment(txn, "max", 2n ** 63n - 1n);
+        assert.throws(() => counters.increment(txn, "max"), /overflow/);
+        assert.throws(() => counters.increment(txn, "max", 1.5), /int64/);
+        counters.put(txn, "text", Buffer.from("abc"));
+        assert.throws(() => counters.increment(txn, "text"), /64-bit counter/);
+        assert.throws(() => dups.increment(txn, 1), /single-value/);
+
+        assert.equal(names.compareAndSwap(txn, "lock", undefined, "a"), true);
+        assert.equal(names.compareAndSwap(txn, "lock", undefined, "b"), false);
+        assert.equal(names.compareAndSwap(txn, "lock", "b", "c"), false);
+        assert.equal(names.compareAndSwap(txn, "lock", "a", "c"), true);
+        assert.equal(names.get(txn, "lock"), "c");
+        assert.equal(names.compareAndSwap(txn, "lock", "c", undefined), true);
+        assert.equal(names.has(txn, "lock"), false);
+        assert.equal(names.compareAndSwap(txn, "lock", "c", "d"), false);
+
+        dups.put(txn, 1, 10);
+        dups.put(txn, 1, 20);
+        assert.equal(dups.compareAndSwap(txn, 1, 10, 15), true);
+        assert.equal(dups.compareAndSwap(txn, 1, 10, 16), false);
+        assert.deepEqual(dups.valuesRange(txn, { start: 1, end: 1 }), [15, 20]);
+        assert.equal(dups.compareAndSwap(txn, 1, 20, undefined), true);
+        assert.equal(dups.compareAndSwap(txn, 1, undefined, 15), false);
+        assert.deepEqual(dups.valuesRange(txn, { start: 1, end: 1 }), [15]);
+        txn.commit();
+
+        const [incremented, swapped] = await env.query([
+            { dbi: counters, mode: queryMode.increment, item: [
+                { key: "hits", delta: 9 }, { key: "fresh" },
+            ] },
+            { dbi: names, mode: queryMode.compareAndSwap, item: [
+                { key: "k", value: "v1" },
+                { key: "k", expected: "v1", value: "v2" },
+                { key: "k", expected: "v1", value: "v3" },
+            ] },
+        ]);
+        assert.deepEqual(incremented, [{ key: "hits", value: 50 }, { key: "fresh", value: 1 }]);
+        assert.deepEqual(swapped.map((r) => r.swapped), [true, true, false]);
+
+        txn = env.startRead();
+        assert.equal(names.get(txn, "k"), "v2");
+        txn.abort();
+
+        assert.throws(() => env.query({
+            dbi: counters, mode: queryMode.increment, item: [{ key: "hits" }],
+        }, MDBX_Param.txnMode.ro), /read-only/);
+        assert.throws(() => env.query({
+            dbi: counters, mode: queryMode.increment | queryMode.get, item: [],
+        }), /queryMode/);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("atomic-update test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,97 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param, MDBX_Batch } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueFlag, valueMode, putFlag } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-batch-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 8 });
+
+        // маленькие буферы проверяют рост и продолжение пакета
+        const batch = new MDBX_Batch({ inputSize: 16, outputSize: 16 });
+
+        let txn = env.startWrite();
+        const strings = txn.createMap({
+            name: "strings", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+        });
+        const signed = txn.createMap({ name: "signed", keyMode: keyMode.int64 });
+        const dups = txn.createMap({
+            name: "dups", keyMode: keyMode.ordinal, valueMode: valueMode.multiOrdinal,
+        });
+
+        for (let i = 0; i < 100; ++i) {
+            batch.put(strings, `key-${i}`, `value-${i}`);
+        }
+        batch.put(strings, "key-0", "again", putFlag.noOverwrite);
+        batch.put(signed, -5, Buffer.from("neg"));
+        batch.put(dups, 1, 20).put(dups, 1, 10);
+        assert.equal(batch.length, 104);
+        let results = batch.execute(txn);
+        assert.equal(batch.length, 0);
+        assert.equal(results.length, 104);
+        assert.ok(results.slice(0, 100).every((r) => r === true));
+        assert.equal(results[100], false);
+        txn.commit();
+
+        txn = env.startRead();
+        assert.equal(strings.get(txn, "key-7"), "value-7");
+        assert.equal(signed.get(txn, -5).toString(), "neg");
+
+        batch.get(strings, "key-0").get(strings, "missing")
+            .has(strings, "key-99").has(strings, "missing")
+            .get(signed, -5).get(dups, 1);
+        batch.get(strings, "long");
+        results = batch.execute(txn);
+        assert.deepEqual(results.slice(0, 4), ["value-0", undefined, true, false]);
+        assert.deepEqual(results[4], Buffer.from("neg"));
+        assert.equal(results[5], 10);
+        assert.equal(results[6], undefined);
+        txn.abort();
+
+        // значение больше выходного буфера
+        txn = env.startWrite();
+        const long = "x".repeat(1000);
+        batch.put(strings, "long", long).get(strings, "long")
+            .del(strings, "key-1").del(strings, "key-1");
+        results = batch.execute(txn);
+        assert.deepEqual(results, [true, long, true, false]);
+
+        assert.throws(() => batch.put(strings, "k", { a: 1 }), /Buffer or String/);
+        assert.throws(() => batch.get(strings, 1), /Buffer or String/);
+
+        // кодеки tuple/object в пакете не работают ни для одной операции
+        const objects = txn.createMap({ name: "objects", valueFlag: valueFlag.object });
+        const tuples = txn.createMap({ name: "tuples", keyFlag: keyFlag.tuple });
+        for (const op of ["get", "has", "del"]) {
+            assert.throws(() => batch[op](objects, "k"), /valueFlag.object/);
+            assert.throws(() => batch[op](tuples, ["k"]), /keyFlag.tuple/);
+        }
+        assert.throws(() => batch.put(objects, "k", { a: 1 }), /valueFlag.object/);
+        assert.throws(() => batch.put(tuples, ["k"], "v"), /keyFlag.tuple/);
+        assert.equal(batch.length, 0);
+
+        // ошибка операции: предыдущие уже выполнены
+        batch.put(strings, "before", "ok").put(strings, "k", "v", putFlag.reserve);
+        assert.throws(() => batch.execute(txn), /execute: op 1/);
+        assert.equal(batch.length, 0);
+        assert.equal(strings.get(txn, "before"), "ok");
+        txn.commit();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("batch test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,149 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { setTimeout: sleep } = require("node:timers/promises");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, valueFlag, queryMode } = MDBX_Param;
+
+async function waitReady(env, dbi) {
+    const deadline = Date.now() + 10000;
+    while (Date.now() < deadline) {
+        // промах по неготовому фильтру запускает построение
+        const txn = env.startRead();
+        dbi.get(txn, "missing");
+        txn.abort();
+        if (dbi.bloomStats().ready) {
+            return;
+        }
+        await sleep(50);
+    }
+    throw new Error("bloom filter was not built");
+}
+
+// фильтр построен, не строится и не переполнен
+async function waitSettled(env, dbi) {
+    const deadline = Date.now() + 10000;
+    while (Date.now() < deadline) {
+        const txn = env.startRead();
+        dbi.get(txn, "missing");
+        txn.abort();
+        const stats = dbi.bloomStats();
+        if (stats.ready && !stats.building && stats.keys <= stats.capacity) {
+            return stats;
+        }
+        await sleep(50);
+    }
+    throw new Error("bloom filter did not settle");
+}
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-bloom-filter-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        const txn = env.startWrite();
+        const dbi = txn.createMap({
+            name: "bloom",
+            keyFlag: keyFlag.string,
+            valueFlag: valueFlag.string,
+            bloom: { bitsPerKey: 12 },
+        });
+        const plain = txn.createMap({ name: "plain" });
+        assert.equal(plain.bloomStats(), undefined);
+        assert.throws(() => txn.openMap({ name: "bloom", bloom: 1 }), /bloom/);
+        assert.throws(() => txn.openMap({
+            name: "bloom", bloom: { bitsPerKey: 0 },
+        }), /bitsPerKey/);
+        for (let i = 0; i < 2000; ++i) {
+            dbi.put(txn, `key-${i}`, `value-${i}`);
+        }
+        txn.commit();
+
+        await waitReady(env, dbi);
+        const stats = dbi.bloomStats();
+        assert.equal(stats.bitsPerKey, 12);
+        assert.ok(stats.keys >= 2000);
+        assert.ok(stats.builds >= 1);
+
+        let rtxn = env.startRead();
+        for (let i = 0; i < 2000; ++i) {
+            assert.equal(dbi.get(rtxn, `key-${i}`), `value-${i}`);
+        }
+        for (let i = 0; i < 2000; ++i) {
+            assert.equal(dbi.get(rtxn, `absent-${i}`), undefined);
+            assert.equal(dbi.has(rtxn, `absent-${i}`), false);
+        }
+        rtxn.abort();
+        const after = dbi.bloomStats();
+        assert.ok(after.negatives - stats.negatives > 3000);
+
+        // запись биндинга продлевает покрытие, новые ключи видны сразу
+        const wtxn = env.startWrite();
+        const same = wtxn.openMap({ name: "bloom", keyFlag: keyFlag.string,
+            valueFlag: valueFlag.string });
+        same.put(wtxn, "late", "value");
+        dbi.del(wtxn, "key-0");
+        wtxn.commit();
+
+        rtxn = env.startRead();
+        assert.equal(dbi.get(rtxn, "late"), "value");
+        assert.equal(dbi.get(rtxn, "key-0"), undefined);
+        const before = dbi.bloomStats().negatives;
+        assert.equal(dbi.get(rtxn, "absent-0"), undefined);
+        assert.equal(dbi.bloomStats().negatives, before + 1);
+        rtxn.abort();
+
+        // проба и запись в одной пишущей транзакции: после первой записи
+        // фильтр по-прежнему отвечает и не перестраивается
+        const settled = await waitSettled(env, dbi);
+        const dtxn = env.startWrite();
+        let inserted = 0;
+        for (let i = 0; i < 200; ++i) {
+            const key = `dedup-${i}`;
+            if (!dbi.has(dtxn, key)) {
+                dbi.put(dtxn, key, "d");
+                ++inserted;
+            }
+        }
+        assert.equal(inserted, 200);
+        assert.equal(dbi.has(dtxn, "dedup-7"), true);
+        const inTxn = dbi.bloomStats();
+        assert.ok(inTxn.negatives - settled.negatives > 190);
+        assert.equal(inTxn.builds, settled.builds);
+        assert.equal(inTxn.building, false);
+        dtxn.commit();
+
+        // фиксация продлила покрытие на следующий снимок
+        rtxn = env.startRead();
+        const next = dbi.bloomStats().negatives;
+        assert.equal(dbi.get(rtxn, "absent-2"), undefined);
+        assert.equal(dbi.bloomStats().negatives, next + 1);
+        assert.equal(dbi.bloomStats().builds, settled.builds);
+        rtxn.abort();
+
+        await env.query([{
+            dbi, mode: queryMode.upsert, item: [{ key: "queried", value: "q" }],
+        }]);
+        const [rows] = await env.query([{
+            dbi, mode: queryMode.get,
+            item: [{ key: "queried" }, { key: "absent-1" }],
+        }]);
+        assert.equal(rows[0].value, "q");
+        assert.equal(rows[1].value, null);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("bloom-filter test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
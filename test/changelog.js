@@ -0,0 +1,116 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-changelog-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: path.join(root, "db"), maxDbi: 8, changelog: { values: true } });
+
+        let txn = env.startWrite();
+        const users = txn.createMap("users");
+        users.put(txn, "alice", "1");
+        users.put(txn, "bob", "2");
+        txn.commit();
+
+        // откат не попадает в журнал
+        txn = env.startWrite();
+        users.put(txn, "ghost", "x");
+        txn.abort();
+
+        txn = env.startWrite();
+        users.del(txn, "bob");
+        const cursor = txn.openCursor(users);
+        cursor.first();
+        cursor.del();
+        cursor.close();
+        txn.commit();
+
+        await env.query({ dbi: users, mode: MDBX_Param.queryMode.upsert,
+            item: [{ key: "carol", value: "3" }] });
+
+        const first = await env.readChanges();
+        const ops = first.changes.map((c) => `${c.op}:${c.key}`);
+        assert.deepEqual(ops, ["put:alice", "put:bob", "del:bob", "del:alice", "put:carol"]);
+        assert.equal(first.changes[0].dbi, users.id);
+        assert.equal(first.changes[0].value.toString(), "1");
+        assert.deepEqual(first.changes.slice(0, 2).map((c) => c.seq), [0, 1]);
+
+        // sinceTxnid пропускает уже прочитанное, транзакция не разрывается
+        const tail = await env.readChanges({ sinceTxnid: first.changes[1].txnId, limit: 1 });
+        assert.deepEqual(tail.changes.map((c) => c.op), ["del", "del"]);
+
+        // хвост через async iterator
+        const ac = new AbortController();
+        const seen = [];
+        const reader = (async () => {
+            for await (const change of env.changes({
+                sinceTxnid: first.txnId, intervalMs: 10, signal: ac.signal })) {
+                seen.push(change.key.toString());
+                if (seen.length === 2) {
+                    ac.abort();
+                }
+            }
+        })();
+        txn = env.startWrite();
+        users.put(txn, "dave", "4");
+        users.put(txn, "erin", "5");
+        txn.commit();
+        await reader;
+        assert.deepEqual(seen, ["dave", "erin"]);
+
+        // отмена на пустом хвосте, пока readChanges() еще в работе
+        const idle = new AbortController();
+        const idleTail = env.changes({ sinceTxnid: Number.MAX_SAFE_INTEGER,
+            intervalMs: 10, signal: idle.signal });
+        const next = idleTail.next();
+        idle.abort();
+        const done = await Promise.race([
+            next,
+            new Promise((resolve) => setTimeout(resolve, 2000, "hang")),
+        ]);
+        assert.deepEqual(done, { value: undefined, done: true });
+
+        // seq идет подряд и без поиска последней записи
+        txn = env.startWrite();
+        for (let i = 0; i < 5; ++i) {
+            users.put(txn, `k${i}`, `${i}`);
+        }
+        txn.commit();
+        const batch = await env.readChanges({ sinceTxnid: first.txnId });
+        const last = batch.changes.filter((c) => c.txnId === batch.txnId);
+        assert.deepEqual(last.map((c) => c.seq), [0, 1, 2, 3, 4]);
+
+        // обрезка: остаются записи начиная с beforeTxnid
+        const before = await env.readChanges();
+        const trimmed = await env.trimChanges({ beforeTxnid: batch.txnId });
+        assert.equal(trimmed, before.changes.length - last.length);
+        const rest = await env.readChanges();
+        assert.deepEqual(rest.changes.map((c) => c.seq), [0, 1, 2, 3, 4]);
+        assert.equal(await env.trimChanges({ beforeTxnid: 0n }), 0);
+        assert.throws(() => env.trimChanges({}), /beforeTxnid is required/);
+    } finally {
+        await env.close();
+    }
+
+    const plain = new MDBX_Env();
+    try {
+        plain.openSync({ path: path.join(root, "plain"), maxDbi: 8 });
+        assert.throws(() => plain.readChanges(), /changelog is not enabled/);
+        assert.throws(() => plain.trimChanges({ beforeTxnid: 1 }), /changelog is not enabled/);
+    } finally {
+        plain.closeSync();
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+    console.log("changelog records binding writes in commit order");
+}
+
+main().catch((error) => {
+    console.error(error);
+    process.exit(1);
+});
@@ -0,0 +1,98 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { Writable } = require("node:stream");
+const { MDBX_Env } = require("../lib/nativemou.js");
+
+const entryCount = 4096;
+
+function openCopy(dir) {
+    const env = new MDBX_Env();
+    env.openSync({ path: dir });
+    const txn = env.startRead();
+    const entries = txn.openMap("items").stat(txn).entries;
+    txn.abort();
+    env.closeSync();
+    return entries;
+}
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-copy-stream-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: path.join(root, "db"), maxDbi: 8 });
+        const txn = env.startWrite();
+        const dbi = txn.createMap("items");
+        const value = Buffer.alloc(1024, 0x33);
+        for (let i = 0; i < entryCount; i++) {
+            dbi.put(txn, `item-${String(i).padStart(6, "0")}`, value);
+        }
+        txn.commit();
+
+        // медленный получатель: в полете не больше четырех кусков
+        const chunks = [];
+        let maxBuffered = 0;
+        let ended = false;
+        const slow = new Writable({
+            highWaterMark: 1,
+            write(chunk, _encoding, callback) {
+                maxBuffered = Math.max(maxBuffered, slow.writableLength);
+                chunks.push(Buffer.from(chunk));
+                setTimeout(callback, 5);
+            },
+            final(callback) {
+                ended = true;
+                callback();
+            },
+        });
+        const { bytesWritten } = await env.copyToStream(slow, { compact: false });
+        await new Promise((resolve) => slow.once("finish", resolve));
+        assert.ok(ended);
+        assert.ok(maxBuffered <= 4 * 1024 * 1024, `buffered ${maxBuffered} bytes`);
+        const streamed = Buffer.concat(chunks);
+        assert.equal(streamed.length, bytesWritten);
+
+        const streamDir = path.join(root, "stream");
+        fs.mkdirSync(streamDir);
+        fs.writeFileSync(path.join(streamDir, "mdbx.dat"), streamed);
+        assert.equal(openCopy(streamDir), entryCount);
+
+        const fdDir = path.join(root, "fd");
+        fs.mkdirSync(fdDir);
+        const fd = fs.openSync(path.join(fdDir, "mdbx.dat"), "wx");
+        try {
+            // ошибки разбора опций называют вызванный метод
+            assert.throws(() => env.copyToFd(fd, 1), /^TypeError: copyToFd: options must be an object/);
+            assert.throws(() => env.copyToFd(fd, { maxBytesPerSec: -1 }),
+                /copyToFd: maxBytesPerSec must be a non-negative number/);
+            await env.copyToFd(fd);
+        } finally {
+            fs.closeSync(fd);
+        }
+        assert.equal(openCopy(fdDir), entryCount);
+
+        // ошибка записи прерывает копирование
+        const failure = new Error("disk full");
+        const broken = new Writable({
+            write(_chunk, _encoding, callback) {
+                callback(failure);
+            },
+        });
+        broken.on("error", () => {});
+        await assert.rejects(env.copyToStream(broken), (error) => error === failure);
+
+        assert.throws(() => env.copyToStream({}), TypeError);
+    } finally {
+        await env.close();
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+    console.log("copyToStream() and copyToFd() produce openable snapshots");
+}
+
+main().catch((error) => {
+    console.error(error);
+    process.exit(1);
+});
@@ -0,0 +1,80 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env } = require("../lib/nativemou.js");
+
+const valueSize = 4096;
+const entryCount = 2048;
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-copy-to-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: path.join(root, "db"), maxDbi: 8 });
+        const txn = env.startWrite();
+        const dbi = txn.createMap("blobs");
+        const value = Buffer.alloc(valueSize, 0x5a);
+        for (let i = 0; i < entryCount; i++) {
+            dbi.put(txn, `key-${String(i).padStart(6, "0")}`, value);
+        }
+        txn.commit();
+
+        // ограниченная копия: прогресс и доступность окружения
+        const reports = [];
+        // копия - это файл данных, окружение открывается по каталогу
+        const copyDir = path.join(root, "copy");
+        fs.mkdirSync(copyDir);
+        const dest = path.join(copyDir, "mdbx.dat");
+        const limit = 4 * 1024 * 1024;
+        const pending = env.copyTo(dest, {
+            maxBytesPerSec: limit,
+            progressIntervalMs: 100,
+            onProgress: (p) => reports.push(p),
+        });
+        const read = env.startRead();
+        assert.equal(read.openMap("blobs").stat(read).entries, entryCount);
+        read.abort();
+        const result = await pending;
+
+        assert.ok(reports.length >= 2, "expected periodic and final progress");
+        assert.equal(reports.at(-1).bytesWritten, result.bytesWritten);
+        assert.equal(fs.statSync(dest).size, result.bytesWritten);
+        const minMs = (result.bytesWritten / limit) * 1000 * 0.5;
+        assert.ok(result.elapsedMs >= minMs,
+            `copy finished in ${result.elapsedMs} ms, limit implies >= ${minMs}`);
+
+        const copy = new MDBX_Env();
+        copy.openSync({ path: copyDir });
+        const check = copy.startRead();
+        assert.equal(check.openMap("blobs").stat(check).entries, entryCount);
+        check.abort();
+        copy.closeSync();
+
+        // существующий файл без overwrite
+        await assert.rejects(env.copyTo(dest, {}));
+        await env.copyTo(dest, { overwrite: true });
+
+        // исключение из onProgress отменяет копию
+        const cancelled = path.join(root, "cancelled.mdbx");
+        const boom = new Error("stop");
+        await assert.rejects(env.copyTo(cancelled, {
+            compact: false,
+            maxBytesPerSec: 1024 * 1024,
+            progressIntervalMs: 0,
+            onProgress: () => { throw boom; },
+        }), (error) => error === boom);
+        assert.equal(fs.existsSync(cancelled), false);
+    } finally {
+        await env.close();
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+    console.log("copyTo() options form is paced and reports progress");
+}
+
+main().catch((error) => {
+    console.error(error);
+    process.exit(1);
+});
@@ -0,0 +1,83 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyMode, valueFlag } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-cursor-renew-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const ids = txn.createMap({
+            name: "ids", keyMode: keyMode.ordinal, valueFlag: valueFlag.string,
+        });
+        const other = txn.createMap({
+            name: "other", keyMode: keyMode.ordinal, valueFlag: valueFlag.string,
+        });
+        for (let i = 0; i < 100; ++i) {
+            ids.put(txn, i, `v${i}`);
+            other.put(txn, i, `o${i}`);
+        }
+        // короткие обходы в цикле берут курсор из кэша транзакции
+        for (let i = 0; i < 100; i += 10) {
+            assert.deepEqual(ids.keysRange(txn, { start: i, limit: 2 }), [i, i + 1]);
+            assert.deepEqual(other.keysRange(txn, { start: i, limit: 1 }), [i]);
+        }
+        // вложенный обход того же DBI получает другой курсор
+        let nested = 0;
+        ids.forEach(txn, (key) => {
+            if (key < 3) {
+                nested += ids.getCount(txn, { start: key });
+            }
+        });
+        assert.equal(nested, 100 + 99 + 98);
+        // кэшированные курсоры не мешают commit
+        txn.commit();
+
+        txn = env.startRead();
+        const cursor = txn.openCursor(ids);
+        assert.equal(cursor.first().key, 0);
+        assert.throws(() => txn.abort(), /cursor\(s\) still open/);
+        cursor.unbind();
+        cursor.unbind();
+        txn.abort();
+
+        txn = env.startWrite();
+        ids.put(txn, 1000, "new");
+        assert.deepEqual(ids.getRange(txn, { start: 99, limit: 3 }).map((r) => r.key), [99, 1000]);
+        ids.drop(txn);
+        assert.equal(ids.getCount(txn), 0);
+        ids.put(txn, 5, "five");
+        txn.commit();
+
+        txn = env.startRead();
+        cursor.renew(txn);
+        assert.equal(cursor.first().value, "five");
+        assert.equal(cursor.next(), undefined);
+        cursor.renew(txn);
+        assert.equal(cursor.seekGE(0).key, 5);
+        cursor.close();
+        txn.abort();
+
+        const closed = env.startRead();
+        assert.throws(() => cursor.renew(closed), /cursor closed/);
+        closed.abort();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("cursor-renew test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
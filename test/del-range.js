@@ -0,0 +1,93 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueFlag, valueMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-del-range-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const ids = txn.createMap({
+            name: "ids", keyMode: keyMode.ordinal, valueFlag: valueFlag.string,
+        });
+        const dups = txn.createMap({
+            name: "dups", keyMode: keyMode.ordinal, valueMode: valueMode.multiOrdinal,
+        });
+        const names = txn.createMap({
+            name: "names", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+        });
+        for (let i = 0; i < 100; ++i) {
+            ids.put(txn, i, `v${i}`);
+        }
+        for (let i = 0; i < 10; ++i) {
+            for (let j = 0; j < 3; ++j) {
+                dups.put(txn, i, j);
+            }
+        }
+        for (const name of ["a1", "a2", "b1", "b2", "b3", "c1"]) {
+            names.put(txn, name, name);
+        }
+        txn.commit();
+
+        txn = env.startWrite();
+        assert.equal(ids.delRange(txn, { start: 10, end: 19 }), 10);
+        assert.equal(ids.has(txn, 9), true);
+        assert.equal(ids.has(txn, 10), false);
+        assert.equal(ids.has(txn, 20), true);
+
+        // limit и обратный обход: удаляются ключи с верхней границы
+        assert.equal(ids.delRange(txn, { start: 30, end: 49, reverse: true, limit: 5 }), 5);
+        assert.deepEqual(ids.keysRange(txn, { start: 40, end: 49 }), [40, 41, 42, 43, 44]);
+        assert.equal(ids.delRange(txn, { start: 90, includeStart: false }), 9);
+        assert.equal(ids.delRange(txn, { start: 200 }), 0);
+        assert.equal(ids.delRange(txn, { limit: 0 }), 0);
+
+        // multi-value: ключ удаляется со всеми значениями и считается один раз
+        assert.equal(dups.delRange(txn, { start: 2, end: 4 }), 3);
+        assert.deepEqual(dups.keysRange(txn, { end: 5 }).filter((k, i, a) => a.indexOf(k) === i),
+            [0, 1, 5]);
+        assert.deepEqual(dups.valuesRange(txn, { start: 1, end: 1 }), [0, 1, 2]);
+        assert.equal(dups.delRange(txn, { offset: 1, limit: 2 }), 2);
+        assert.deepEqual(dups.keysRange(txn).filter((k, i, a) => a.indexOf(k) === i),
+            [0, 6, 7, 8, 9]);
+
+        assert.equal(names.delRange(txn, { prefix: "b" }), 3);
+        assert.deepEqual(names.keysRange(txn), ["a1", "a2", "c1"]);
+        txn.commit();
+
+        txn = env.startRead();
+        assert.equal(ids.getCount(txn), 100 - 10 - 5 - 9);
+        assert.throws(() => ids.delRange(txn, { start: 0 }), /delRange/);
+        txn.abort();
+
+        // асинхронный вариант в своей пишущей транзакции
+        assert.equal(await env.delRange({ dbi: ids, end: 49 }), 35);
+        assert.equal(await env.delRange({ dbi: dups }), 5);
+        txn = env.startRead();
+        assert.deepEqual(ids.keysRange(txn, { limit: 2 }), [50, 51]);
+        assert.equal(dups.getCount(txn), 0);
+        txn.abort();
+
+        assert.throws(() => env.delRange({ dbi: ids, limit: -1 }), /limit/);
+        // сам dbi без опций не означает "удалить все"
+        assert.throws(() => env.delRange(ids), /delRange/);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("del-range test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
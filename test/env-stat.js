@@ -0,0 +1,55 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-env-stat-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: path.join(root, "db"), maxDbi: 8 });
+
+        const txn = env.startWrite();
+        const users = txn.createMap("users");
+        const counters = txn.createMap("counters", MDBX_Param.keyMode.ordinal);
+        for (let i = 0; i < 100; i++) {
+            users.put(txn, `user-${i}`, `value-${i}`);
+        }
+        counters.put(txn, 1, "one");
+        txn.commit();
+
+        const result = await env.stat({ dbis: [users, counters] });
+        assert.equal(typeof result.txnId, "number");
+        assert.ok(result.env.entries >= 101);
+        assert.ok(result.info.mapSize > 0);
+        assert.ok(result.info.maxReaders > 0);
+        assert.equal(result.dbis.length, 2);
+        assert.equal(result.dbis[0].entries, 100);
+        assert.equal(result.dbis[1].entries, 1);
+        assert.equal(result.dbis[1].flags & MDBX_Param.keyMode.ordinal,
+            MDBX_Param.keyMode.ordinal);
+
+        // Форма совпадает с синхронным dbi.stat()
+        const read = env.startRead();
+        assert.deepEqual(Object.keys(users.stat(read)).sort(),
+            Object.keys(result.dbis[0]).filter((k) => k !== "flags").sort());
+        read.abort();
+
+        const bare = await env.stat();
+        assert.deepEqual(bare.dbis, []);
+
+        assert.throws(() => env.stat({ dbis: [{}] }));
+    } finally {
+        await env.close();
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+    console.log("env.stat() returns one snapshot of env and DBI statistics");
+}
+
+main().catch((error) => {
+    console.error(error);
+    process.exit(1);
+});
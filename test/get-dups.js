@@ -0,0 +1,78 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-get-dups-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const postings = txn.createMap({
+            name: "postings", keyFlag: keyFlag.string, valueMode: valueMode.multiOrdinal,
+        });
+        const records = txn.createMap({
+            name: "records", keyMode: keyMode.ordinal, valueMode: valueMode.multiSamelength,
+        });
+        const plain = txn.createMap({ name: "plain", keyFlag: keyFlag.string });
+
+        // 20000 значений занимают много страниц вложенного дерева
+        const many = new BigUint64Array(20000);
+        for (let i = 0; i < many.length; ++i) {
+            many[i] = BigInt(i * 3);
+        }
+        postings.putDups(txn, "many", many);
+        postings.putDups(txn, "one", [7]);
+        postings.putDups(txn, "two", [2, 1]);
+        for (const word of ["dddd", "aaaa", "cccc"]) {
+            records.put(txn, 1, Buffer.from(word));
+        }
+        plain.put(txn, "k", Buffer.from("v"));
+        txn.commit();
+
+        txn = env.startRead();
+        const all = postings.getAllDups(txn, "many");
+        assert.ok(all instanceof BigUint64Array);
+        assert.deepEqual(all, many);
+        assert.deepEqual(postings.getAllDups(txn, "one"), new BigUint64Array([7n]));
+        assert.equal(postings.getAllDups(txn, "none"), undefined);
+
+        const bytes = records.getAllDups(txn, 1);
+        assert.ok(bytes instanceof Uint8Array);
+        assert.equal(Buffer.from(bytes).toString(), "aaaaccccdddd");
+        assert.throws(() => plain.getAllDups(txn, "k"), /fixed-size multi-value/);
+
+        // курсор: по ключам, значения каждого ключа одним массивом
+        const cursor = txn.openCursor(postings);
+        const seen = [];
+        for (let item = cursor.first(); item; item = cursor.next()) {
+            seen.push([item.key, cursor.getDups().length]);
+        }
+        assert.deepEqual(seen, [["many", 20000], ["one", 1], ["two", 2]]);
+        assert.deepEqual(cursor.getDups("two"), new BigUint64Array([1n, 2n]));
+        assert.equal(cursor.getDups("none"), undefined);
+        // с середины набора значений getDups начинает с первого
+        cursor.seek("many");
+        cursor.next();
+        assert.equal(cursor.getDups()[0], 0n);
+        cursor.close();
+        txn.abort();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("get-dups test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
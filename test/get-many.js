@@ -0,0 +1,82 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueFlag } = MDBX_Param;
+
+function bit(bitmap, i) {
+    return (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-get-many-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        const txn = env.startWrite();
+        const strings = txn.createMap({
+            name: "strings", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+        });
+        const ids = txn.createMap({
+            name: "ids", keyMode: keyMode.ordinal, valueFlag: valueFlag.string,
+        });
+        const signed = txn.createMap({
+            name: "signed", keyMode: keyMode.int64, valueFlag: valueFlag.string,
+        });
+        for (let i = 0; i < 100; i += 2) {
+            strings.put(txn, `k${i}`, `v${i}`);
+            ids.put(txn, i, `id${i}`);
+            signed.put(txn, i - 50, `s${i - 50}`);
+        }
+        txn.commit();
+
+        const rtxn = env.startRead();
+        assert.deepEqual(strings.getMany(rtxn, ["k10", "k11", "k0", "k10", "zz"]),
+            ["v10", undefined, "v0", "v10", undefined]);
+        assert.deepEqual(strings.getMany(rtxn, []), []);
+
+        const keys = [98, 1, 0, 50, 51, 7, 2];
+        const bitmap = ids.hasMany(rtxn, keys);
+        assert.ok(bitmap instanceof Uint8Array);
+        assert.equal(bitmap.length, 1);
+        assert.deepEqual(keys.map((_, i) => bit(bitmap, i)), [1, 0, 1, 1, 0, 0, 1]);
+
+        assert.deepEqual(ids.getMany(rtxn, new BigUint64Array([4n, 5n, 0n])),
+            ["id4", undefined, "id0"]);
+        assert.deepEqual(ids.getMany(rtxn, new Uint32Array([6, 8])), ["id6", "id8"]);
+        assert.deepEqual(signed.getMany(rtxn, new Int32Array([-50, -49, 48])),
+            ["s-50", undefined, "s48"]);
+        assert.deepEqual(signed.getMany(rtxn, [-2, -2n]), ["s-2", "s-2"]);
+
+        const many = Array.from({ length: 20 }, (_, i) => `k${i}`);
+        const present = strings.hasMany(rtxn, many);
+        assert.equal(present.length, 3);
+        for (let i = 0; i < many.length; ++i) {
+            assert.equal(bit(present, i), i % 2 === 0 ? 1 : 0);
+        }
+
+        assert.throws(() => strings.getMany(rtxn, new Uint32Array([1])), /ordinal keyMode/);
+        assert.throws(() => ids.getMany(rtxn, new Int32Array([-1])), /negative/);
+        assert.throws(() => ids.getMany(rtxn, new Float64Array([1.5])), /uint64 integer/);
+        assert.throws(() => ids.getMany(rtxn, new Float64Array([NaN])), /uint64 integer/);
+        assert.throws(() => ids.getMany(rtxn, new Float64Array([2 ** 64])), /uint64 integer/);
+        assert.throws(() => ids.hasMany(rtxn, new Float32Array([0.25])), /uint64 integer/);
+        assert.throws(() => strings.getMany(rtxn, "k0"), /Array/);
+        rtxn.abort();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("get-many test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,130 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const objectFlag = MDBX_Param.valueFlag.object;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-object-values-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        const seen = new Date(Date.UTC(2024, 1, 29, 12, 30, 15, 250));
+        const record = {
+            name: "Анна",
+            age: 37,
+            score: -1.25,
+            big: -(2n ** 60n),
+            huge: 2n ** 64n - 1n,
+            wide: 2 ** 40,
+            negative: -100000,
+            active: true,
+            none: null,
+            tags: ["a", "b", 3, [null]],
+            raw: Buffer.from([1, 2, 3]),
+            seen,
+            nested: { deep: { deeper: { value: "x".repeat(300) } } },
+        };
+
+        const txn = env.startWrite();
+        const dbi = txn.createMap({ name: "objects", valueFlag: objectFlag });
+        assert.equal(dbi.valueFlag, objectFlag);
+        dbi.put(txn, "record", record);
+        dbi.put(txn, "skip", { a: 1, b: undefined, f() {} });
+        dbi.put(txn, "array", [1, "two", { three: 3 }]);
+        dbi.put(txn, "scalar", "just a string");
+
+        const cursor = txn.openCursor(dbi);
+        cursor.put("cursor", { via: "cursor" });
+        cursor.close();
+
+        // циклы и неподдерживаемые типы
+        const cyclic = {};
+        cyclic.self = cyclic;
+        assert.throws(() => dbi.put(txn, "cyclic", cyclic), /nesting too deep/);
+        assert.throws(() => dbi.put(txn, "symbol", { s: Symbol("x") }),
+            /unsupported value type/);
+
+        // MessagePack с ключом "__proto__", записанный в обход кодека
+        const rawWrite = txn.openMap({ name: "objects" });
+        rawWrite.put(txn, "proto", Buffer.concat([
+            Buffer.from([0x81, 0xa9]), Buffer.from("__proto__"),
+            Buffer.from([0x81, 0xa8]), Buffer.from("polluted"), Buffer.from([0x01]),
+        ]));
+        txn.commit();
+
+        const readTxn = env.startRead();
+        const readDbi = readTxn.openMap({ name: "objects", valueFlag: objectFlag });
+        const back = readDbi.get(readTxn, "record");
+        assert.equal(back.name, record.name);
+        assert.equal(back.age, 37);
+        assert.equal(back.score, -1.25);
+        assert.equal(back.big, record.big);
+        assert.equal(back.huge, record.huge);
+        assert.equal(back.wide, 2 ** 40);
+        assert.equal(back.negative, -100000);
+        assert.equal(back.active, true);
+        assert.equal(back.none, null);
+        assert.deepEqual(back.tags, record.tags);
+        assert.ok(Buffer.isBuffer(back.raw));
+        assert.deepEqual([...back.raw], [1, 2, 3]);
+        assert.ok(back.seen instanceof Date);
+        assert.equal(back.seen.getTime(), seen.getTime());
+        assert.equal(back.nested.deep.deeper.value.length, 300);
+
+        assert.deepEqual(readDbi.get(readTxn, "skip"), { a: 1 });
+        assert.deepEqual(readDbi.get(readTxn, "array"), [1, "two", { three: 3 }]);
+        assert.equal(readDbi.get(readTxn, "scalar"), "just a string");
+        assert.deepEqual(readDbi.get(readTxn, "cursor"), { via: "cursor" });
+
+        // "__proto__" становится собственным свойством, прототип не меняется
+        const proto = readDbi.get(readTxn, "proto");
+        assert.equal(Object.getPrototypeOf(proto), Object.prototype);
+        assert.equal(proto.polluted, undefined);
+        assert.deepEqual(Object.keys(proto), ["__proto__"]);
+        assert.deepEqual(Object.getOwnPropertyDescriptor(proto, "__proto__").value,
+            { polluted: 1 });
+
+        // на диске - обычный MessagePack
+        const rawDbi = readTxn.openMap({ name: "objects" });
+        assert.deepEqual([...rawDbi.get(readTxn, "skip")], [0x81, 0xa1, 0x61, 0x01]);
+
+        const items = [];
+        readDbi.forEach(readTxn, (key, value) => {
+            items.push([key.toString(), value]);
+        });
+        assert.equal(items.length, 6);
+        readTxn.abort();
+
+        // query() пишет и читает тем же кодеком
+        const qtxn = env.startRead();
+        const qdbi = qtxn.openMap({ name: "objects", valueFlag: objectFlag });
+        qtxn.abort();
+        await env.query([{
+            dbi: qdbi,
+            mode: MDBX_Param.queryMode.upsert,
+            item: [{ key: "query", value: { from: "query", n: [1, 2] } }],
+        }]);
+        const [rows] = await env.query([{
+            dbi: qdbi,
+            mode: MDBX_Param.queryMode.get,
+            item: [{ key: "query" }],
+        }]);
+        assert.deepEqual(rows[0].value, { from: "query", n: [1, 2] });
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("object-values test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
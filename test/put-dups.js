@@ -0,0 +1,71 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueMode, queryMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-put-dups-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const postings = txn.createMap({
+            name: "postings", keyFlag: keyFlag.string, valueMode: valueMode.multiOrdinal,
+        });
+        const plain = txn.createMap({ name: "plain", keyMode: keyMode.ordinal });
+
+        postings.putDups(txn, "a", new BigUint64Array([30n, 10n, 20n]));
+        // существующие значения пропускаются
+        postings.putDups(txn, "a", new Uint32Array([20, 40]));
+        postings.putDups(txn, "b", [5, 6n]);
+        postings.putDups(txn, "c", new BigUint64Array(0));
+        assert.deepEqual(postings.valuesRange(txn, { start: "a", end: "a" }), [10, 20, 30, 40]);
+        assert.deepEqual(postings.valuesRange(txn, { start: "b", end: "b" }), [5, 6]);
+        assert.equal(postings.has(txn, "c"), false);
+
+        const many = new BigUint64Array(5000);
+        for (let i = 0; i < many.length; ++i) {
+            many[i] = BigInt(i * 2);
+        }
+        postings.putDups(txn, "many", many);
+        assert.equal(postings.valuesRange(txn, { start: "many", end: "many" }).length, 5000);
+
+        assert.throws(() => plain.putDups(txn, 1, [1]), /multiOrdinal/);
+        assert.throws(() => postings.putDups(txn, "x", new Int32Array([1])), /BigUint64Array/);
+        assert.throws(() => postings.putDups(txn, "x", [-1]), /negative/);
+        txn.commit();
+
+        const [row] = await env.query([
+            { dbi: postings, mode: queryMode.putDups, item: [
+                { key: "a", value: new Uint32Array([50, 10]) },
+                { key: "d", value: new BigUint64Array([7n]) },
+            ] },
+        ]);
+        assert.deepEqual(row, [{ key: "a", count: 2 }, { key: "d", count: 1 }]);
+
+        txn = env.startRead();
+        assert.deepEqual(postings.valuesRange(txn, { start: "a", end: "a" }), [10, 20, 30, 40, 50]);
+        assert.deepEqual(postings.valuesRange(txn, { start: "d", end: "d" }), [7]);
+        txn.abort();
+
+        assert.throws(() => env.query({
+            dbi: plain, mode: queryMode.putDups, item: [{ key: 1, value: [1] }],
+        }), /multiOrdinal/);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("put-dups test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -47,6 +47,24 @@ const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
   assert.strictEqual(results[1][1].key, 2);
   assert.strictEqual(results[1][1].value, bob);
 
+  const counters = await env.query([
+    {
+      dbi,
+      mode: MDBX_Param.queryMode.increment,
+      item: [{ key: 10, delta: 5 }, { key: 11 }],
+    },
+    {
+      dbi,
+      mode: MDBX_Param.queryMode.compareAndSwap,
+      item: [{ key: 2, expected: bob, value: "Bobby" }],
+    },
+  ]);
+
+  assert.deepStrictEqual(counters, [
+    [{ key: 10, value: 5 }, { key: 11, value: 1 }],
+    [{ key: 2, swapped: true }],
+  ]);
+
   await env.close();
   await fs.promises.rm(dbPath, { recursive: true, force: true });
 
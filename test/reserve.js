@@ -0,0 +1,103 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueFlag, valueMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-reserve-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const blobs = txn.createMap({ name: "blobs", keyFlag: keyFlag.string });
+        const dups = txn.createMap({
+            name: "dups", keyMode: keyMode.ordinal, valueMode: valueMode.multiOrdinal,
+        });
+
+        const view = blobs.reserve(txn, "a", 16);
+        assert.ok(view instanceof DataView);
+        assert.equal(view.byteLength, 16);
+        view.setUint32(0, 0xdeadbeef, true);
+        new Uint8Array(view.buffer, view.byteOffset + 4, 12).fill(7);
+        assert.deepEqual(blobs.get(txn, "a").subarray(0, 6),
+            Buffer.from([0xef, 0xbe, 0xad, 0xde, 7, 7]));
+
+        // следующая запись отсоединяет вид
+        blobs.put(txn, "b", Buffer.from("b"));
+        assert.equal(view.buffer.byteLength, 0);
+
+        const empty = blobs.reserve(txn, "empty", 0);
+        assert.equal(empty.byteLength, 0);
+        const last = blobs.reserve(txn, "c", 4);
+        last.setUint32(0, 42, true);
+        txn.commit();
+        assert.equal(last.buffer.byteLength, 0);
+
+        txn = env.startRead();
+        assert.equal(blobs.get(txn, "a").readUInt32LE(0), 0xdeadbeef);
+        assert.equal(blobs.get(txn, "c").readUInt32LE(0), 42);
+        assert.equal(blobs.get(txn, "empty").length, 0);
+        assert.throws(() => blobs.reserve(txn, "x", 1), /write transaction/);
+        txn.abort();
+
+        txn = env.startWrite();
+        assert.throws(() => dups.reserve(txn, 1, 8), /multi-value/);
+        assert.throws(() => blobs.reserve(txn, "x", -1), /size/);
+        assert.throws(() => blobs.reserve(txn, "x", 1.5), /size/);
+        const aborted = blobs.reserve(txn, "x", 8);
+        txn.abort();
+        assert.equal(aborted.buffer.byteLength, 0);
+
+        txn = env.startRead();
+        assert.equal(blobs.has(txn, "x"), false);
+        txn.abort();
+    } finally {
+        env.closeSync();
+    }
+
+    // журнал со значениями не может записать байты резерва
+    const logged = new MDBX_Env();
+    try {
+        logged.openSync({ path: path.join(dir, "logged"), maxDbi: 4,
+            changelog: { values: true } });
+        const txn = logged.startWrite();
+        const blobs = txn.createMap({ name: "blobs", keyFlag: keyFlag.string });
+        assert.throws(() => blobs.reserve(txn, "a", 4),
+            /reserve: not supported while the change log records values/);
+        blobs.put(txn, "b", Buffer.from("b"));
+        txn.commit();
+        const { changes } = await logged.readChanges();
+        assert.deepEqual(changes.map((c) => `${c.op}:${c.key}`), ["put:b"]);
+    } finally {
+        logged.closeSync();
+    }
+
+    // журнал только ключей резерв допускает
+    const keysOnly = new MDBX_Env();
+    try {
+        keysOnly.openSync({ path: path.join(dir, "keys"), maxDbi: 4,
+            changelog: true });
+        const txn = keysOnly.startWrite();
+        const blobs = txn.createMap({ name: "blobs", keyFlag: keyFlag.string });
+        blobs.reserve(txn, "a", 4).setUint32(0, 1, true);
+        txn.commit();
+        const { changes } = await keysOnly.readChanges();
+        assert.deepEqual(changes.map((c) => `${c.op}:${c.key}`), ["put:a"]);
+    } finally {
+        keysOnly.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("reserve test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
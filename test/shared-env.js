@@ -0,0 +1,105 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { Worker, isMainThread, parentPort, workerData } = require("node:worker_threads");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const workerCount = 4;
+const keyCount = 1000;
+
+function key(i) {
+    return `key-${String(i).padStart(6, "0")}`;
+}
+
+if (!isMainThread) {
+    // тот же путь, что и в главном потоке: окружение общее для процесса
+    const env = new MDBX_Env();
+    env.openSync({ path: workerData.dbPath, maxDbi: 4 });
+    let found = 0;
+    for (let round = 0; round < 20; round++) {
+        const txn = env.startRead();
+        const dbi = txn.openMap("values");
+        for (let i = 0; i < keyCount; i++) {
+            if (dbi.get(txn, key(i)) === `value-${i}`) {
+                found++;
+            }
+        }
+        txn.abort();
+    }
+    env.closeSync();
+    parentPort.postMessage({ found });
+    return;
+}
+
+function runWorker(dbPath) {
+    return new Promise((resolve, reject) => {
+        const worker = new Worker(__filename, { workerData: { dbPath } });
+        worker.once("message", resolve);
+        worker.once("error", reject);
+        worker.once("exit", (code) => {
+            if (code !== 0) {
+                reject(new Error(`worker exited with code ${code}`));
+            }
+        });
+    });
+}
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-shared-env-"));
+    try {
+        const env = new MDBX_Env();
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        const txn = env.startWrite();
+        const dbi = txn.createMap("values");
+        for (let i = 0; i < keyCount; i++) {
+            dbi.put(txn, key(i), `value-${i}`);
+        }
+        txn.commit();
+
+        // главный поток держит свою читающую транзакцию, пока работают воркеры
+        const readTxn = env.startRead();
+        const results = await Promise.all(
+            Array.from({ length: workerCount }, () => runWorker(dir)));
+        for (const { found } of results) {
+            assert.equal(found, keyCount * 20);
+        }
+        assert.equal(readTxn.openMap("values").get(readTxn, key(7)), "value-7");
+        readTxn.abort();
+
+        // второй фасад в том же изоляте с несовместимыми параметрами
+        const other = new MDBX_Env();
+        assert.throws(
+            () => other.openSync({ path: dir, maxDbi: 64 }),
+            /already opened in this process/);
+        assert.throws(
+            () => other.openSync({ path: dir, maxDbi: 4,
+                flags: MDBX_Param.envFlag.rdonly }),
+            /already opened in this process/);
+
+        // совместимый фасад работает и переживает закрытие первого
+        other.openSync({ path: path.join(dir, "."), maxDbi: 2 });
+        env.closeSync();
+        const check = other.startRead();
+        assert.equal(check.openMap("values").get(check, key(999)), "value-999");
+        check.abort();
+        other.closeSync();
+
+        // после закрытия последнего фасада путь открывается заново
+        const reopened = new MDBX_Env();
+        reopened.openSync({ path: dir, maxDbi: 64 });
+        reopened.closeSync();
+    } finally {
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("shared-env test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
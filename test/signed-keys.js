@@ -0,0 +1,97 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyMode, keyFlag } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-signed-keys-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        const ints = [-(2 ** 53) + 1, -100000, -256, -1, 0, 1, 255, 2 ** 40];
+        const floats = [-Infinity, -1e300, -1.5, -Number.MIN_VALUE, 0,
+            Number.MIN_VALUE, 0.25, 1, 10.5, Infinity];
+
+        const txn = env.startWrite();
+        const i64 = txn.createMap({ name: "i64", keyMode: keyMode.int64 });
+        const f64 = txn.createMap({ name: "f64", keyMode: keyMode.float64 });
+        const big = txn.createMap({
+            name: "big", keyMode: keyMode.int64, keyFlag: keyFlag.bigint,
+        });
+        assert.equal(i64.keyMode, keyMode.int64);
+        assert.equal(f64.keyMode, keyMode.float64);
+        // пишем в обратном порядке, порядок дает сама база
+        for (const k of [...ints].reverse()) {
+            i64.put(txn, k, `i${k}`);
+        }
+        for (const k of [...floats].reverse()) {
+            f64.put(txn, k, `f${k}`);
+        }
+        for (const k of [-(2n ** 63n), -5n, 5n, 2n ** 63n - 1n]) {
+            big.put(txn, k, `b${k}`);
+        }
+        f64.put(txn, -0, "zero");
+
+        assert.throws(() => i64.put(txn, 1.5, "x"), /int64 integer/);
+        assert.throws(() => big.put(txn, 2n ** 63n, "x"), /int64 range/);
+        assert.throws(() => f64.put(txn, NaN, "x"), /NaN/);
+        assert.throws(() => f64.put(txn, 1n, "x"), /must be a Number/);
+        txn.commit();
+
+        const rtxn = env.startRead();
+        const ri64 = rtxn.openMap({ name: "i64", keyMode: keyMode.int64 });
+        const rf64 = rtxn.openMap({ name: "f64", keyMode: keyMode.float64 });
+        const rbig = rtxn.openMap({
+            name: "big", keyMode: keyMode.int64, keyFlag: keyFlag.bigint,
+        });
+
+        assert.deepEqual(ri64.keys(rtxn), ints);
+        assert.deepEqual(rf64.keys(rtxn), floats);
+        assert.deepEqual(rbig.keys(rtxn), [-(2n ** 63n), -5n, 5n, 2n ** 63n - 1n]);
+        assert.equal(rf64.get(rtxn, 0), "zero");
+        assert.equal(ri64.get(rtxn, -256), "i-256");
+        assert.equal(ri64.get(rtxn, -256n), "i-256");
+
+        assert.deepEqual(ri64.keysRange(rtxn, { start: -300, end: 0 }), [-256, -1, 0]);
+        assert.deepEqual(ri64.keysRange(rtxn, { end: -1, reverse: true }),
+            [-1, -256, -100000, -(2 ** 53) + 1]);
+        assert.deepEqual(rf64.keysRange(rtxn, { start: -2, end: 1, includeEnd: false }),
+            [-1.5, -Number.MIN_VALUE, 0, Number.MIN_VALUE, 0.25]);
+        assert.equal(rf64.getCount(rtxn, { start: 0 }), 6);
+
+        const cursor = rtxn.openCursor(rf64);
+        assert.equal(cursor.seekGE(-1).key, -Number.MIN_VALUE);
+        cursor.close();
+        rtxn.abort();
+
+        const [rows] = await env.query([{
+            dbi: ri64,
+            mode: MDBX_Param.queryMode.get,
+            item: [{ key: -100000 }],
+        }]);
+        assert.equal(rows[0].key, -100000);
+        assert.equal(rows[0].value.toString(), "i-100000");
+
+        const wtxn = env.startWrite();
+        assert.throws(() => wtxn.createMap({
+            name: "bad", keyMode: keyMode.int64 | keyMode.float64,
+        }), /int64 or float64/);
+        wtxn.abort();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("signed-keys test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,105 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { setTimeout: sleep } = require("node:timers/promises");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, valueFlag, envFlag } = MDBX_Param;
+
+function openEnv(dir, flags) {
+    const env = new MDBX_Env();
+    env.openSync(flags === undefined ?
+        { path: dir, maxDbi: 4 } : { path: dir, maxDbi: 4, flags });
+    const txn = env.startWrite();
+    const dbi = txn.createMap({
+        name: "names", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+    });
+    dbi.put(txn, "k", "v1");
+    txn.commit();
+    return { env, dbi };
+}
+
+function put(env, dbi, value) {
+    const txn = env.startWrite();
+    dbi.put(txn, "k", value);
+    txn.commit();
+}
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-snapshot-"));
+    try {
+        {
+            const { env, dbi } = openEnv(path.join(root, "nosticky"), envFlag.nostickythreads);
+            const a = env.snapshot({ maxAgeMs: 1000 });
+            const b = env.snapshot({ maxAgeMs: 1000 });
+            assert.equal(a.txn, b.txn);
+            assert.equal(dbi.get(a.txn, "k"), "v1");
+            put(env, dbi, "v2");
+            // в пределах maxAgeMs отдается тот же снимок
+            const c = env.snapshot({ maxAgeMs: 1000 });
+            assert.equal(c.txn, a.txn);
+            assert.equal(dbi.get(c.txn, "k"), "v1");
+            c.release();
+            c.release();
+
+            // устаревший снимок заменяется, старый живет до последнего release()
+            const fresh = env.snapshot({ maxAgeMs: 0 });
+            assert.notEqual(fresh.txn, a.txn);
+            assert.equal(dbi.get(fresh.txn, "k"), "v2");
+            assert.equal(a.txn.isActive(), true);
+            a.release();
+            assert.equal(a.txn.isActive(), true);
+            b.release();
+            assert.equal(a.txn.isActive(), false);
+
+            assert.throws(() => env.closeSync(), /transaction in progress/);
+            fresh.release();
+            assert.equal(fresh.txn.isActive(), false);
+
+            // используемый снимок обновляется в фоне, занятый старый живет
+            const held = env.snapshot({ maxAgeMs: 30 });
+            put(env, dbi, "v3");
+            await sleep(60);
+            const renewed = env.snapshot({ maxAgeMs: 1000 });
+            assert.notEqual(renewed.txn, held.txn);
+            assert.equal(dbi.get(renewed.txn, "k"), "v3");
+            assert.equal(held.txn.isActive(), true);
+            assert.equal(dbi.get(held.txn, "k"), "v2");
+            held.release();
+            assert.equal(held.txn.isActive(), false);
+            renewed.release();
+
+            // простаивающий снимок прерывается таймером
+            const idle = env.snapshot({ maxAgeMs: 20 });
+            idle.release();
+            assert.equal(idle.txn.isActive(), true);
+            await sleep(60);
+            assert.equal(idle.txn.isActive(), false);
+
+            assert.throws(() => env.snapshot({ maxAgeMs: -1 }), /maxAgeMs/);
+            const open = env.snapshot({ maxAgeMs: 1000 });
+            open.release();
+            env.closeSync();
+            assert.equal(open.txn.isActive(), false);
+        }
+        {
+            // без nostickythreads открытый снимок занял бы читателя потока
+            const { env } = openEnv(path.join(root, "sticky"));
+            assert.throws(() => env.snapshot(), /requires envFlag.nostickythreads/);
+            env.startRead().abort();
+            env.closeSync();
+        }
+    } finally {
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("snapshot test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,197 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const tupleFlag = MDBX_Param.keyFlag.tuple;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-tuple-keys-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 8 });
+
+        // ожидаемый порядок: null, байты, строки, числа, false, true;
+        // Number и BigInt - в одном числовом порядке
+        const ordered = [
+            [null],
+            [Buffer.from([0x00])],
+            [Buffer.from([0x00, 0x01])],
+            [""],
+            ["a"],
+            ["a", -1],
+            ["a", 0],
+            ["a", 1],
+            ["a\u0000b"],
+            ["ab"],
+            [-Infinity],
+            [-1e300],
+            [-(2n ** 64n) + 1n],
+            [-(2n ** 64n) + 2048n],
+            [-(2n ** 64n) + 2049n],
+            [-(2 ** 40)],
+            [-256],
+            [-255],
+            [-1.5],
+            [-1],
+            [-0.5],
+            [0],
+            [0.5],
+            [1],
+            [2.5],
+            [3n],
+            [255],
+            [256],
+            [Number.MAX_SAFE_INTEGER],
+            [2n ** 53n + 1n],
+            [2 ** 60],
+            [2n ** 60n + 1n],
+            [2n ** 64n - 1n],
+            [1e300],
+            [Infinity],
+            [false],
+            [true],
+        ];
+        const safe = (e) => typeof e === "bigint" &&
+            e >= -BigInt(Number.MAX_SAFE_INTEGER) &&
+            e <= BigInt(Number.MAX_SAFE_INTEGER);
+        const big = (e) => typeof e === "number" && Number.isInteger(e) &&
+            !Number.isSafeInteger(e) && Math.abs(e) < 2 ** 64;
+        // так ключи возвращаются при чтении
+        const decoded = (t) => t.map((e) =>
+            safe(e) ? Number(e) : (big(e) ? BigInt(e) : e));
+
+        const txn = env.startWrite();
+        const dbi = txn.createMap({ name: "tuples", keyFlag: tupleFlag });
+        assert.equal(dbi.keyFlag, tupleFlag);
+        // пишем в обратном порядке, чтобы порядок дала сама база
+        for (let i = ordered.length - 1; i >= 0; i--) {
+            dbi.put(txn, ordered[i], `v${i}`);
+        }
+        assert.throws(() => dbi.put(txn, "not an array", "x"),
+            /key must be an Array/);
+        assert.throws(() => dbi.put(txn, [{}], "x"),
+            /unsupported element type/);
+        assert.throws(() => dbi.put(txn, [2n ** 64n], "x"),
+            /out of 64-bit range/);
+        assert.throws(() => txn.createMap({
+            name: "bad", keyFlag: tupleFlag, keyMode: MDBX_Param.keyMode.ordinal,
+        }), /keyFlag.tuple requires the default keyMode/);
+        txn.commit();
+
+        const rtxn = env.startRead();
+        const rdbi = rtxn.openMap({ name: "tuples", keyFlag: tupleFlag });
+        const keys = rdbi.keys(rtxn);
+        assert.equal(keys.length, ordered.length);
+        assert.deepEqual(keys, ordered.map(decoded));
+        assert.equal(rdbi.get(rtxn, ["a", 0]), "v6");
+        assert.equal(rdbi.get(rtxn, ["a", 0n]), "v6");
+        assert.equal(rdbi.get(rtxn, [-0]), rdbi.get(rtxn, [0]));
+        // равные Number и BigInt - один ключ
+        const i60 = ordered.findIndex((t) => t[0] === 2 ** 60);
+        assert.equal(rdbi.get(rtxn, [2n ** 60n]), `v${i60}`);
+        rtxn.abort();
+
+        // диапазон по целым не пропускает дробные значения
+        const ntxn = env.startWrite();
+        const nums = ntxn.createMap({ name: "nums", keyFlag: tupleFlag });
+        for (const k of [0, 1, 2, 2.5, 3, 10, 10.5]) {
+            nums.put(ntxn, ["t", k], String(k));
+        }
+        nums.put(ntxn, ["t", 7n], "7n");
+        assert.deepEqual(nums.valuesRange(ntxn, { start: ["t", 0], end: ["t", 10] }),
+            ["0", "1", "2", "2.5", "3", "7n", "10"]);
+        assert.throws(() => nums.put(ntxn, ["t", NaN], "x"), /NaN/);
+        ntxn.commit();
+
+        // составные ключи и префиксы
+        const wtxn = env.startWrite();
+        const events = wtxn.createMap({ name: "events", keyFlag: tupleFlag });
+        events.put(wtxn, ["acme", 1700000000, -5], "a");
+        events.put(wtxn, ["acme", 1700000100, 7], "b");
+        events.put(wtxn, ["acme", 1700000100, 8], "c");
+        events.put(wtxn, ["acmf", 1, 1], "d");
+        events.put(wtxn, ["zeta", 1, 1], "e");
+        wtxn.commit();
+
+        const ptxn = env.startRead();
+        const pdbi = ptxn.openMap({ name: "events", keyFlag: tupleFlag });
+        assert.deepEqual(pdbi.valuesRange(ptxn, { prefix: ["acme"] }), ["a", "b", "c"]);
+        assert.deepEqual(pdbi.valuesRange(ptxn, { prefix: ["acme"], reverse: true }),
+            ["c", "b", "a"]);
+        assert.deepEqual(pdbi.valuesRange(ptxn, { prefix: ["acme", 1700000100] }),
+            ["b", "c"]);
+        assert.deepEqual(pdbi.valuesRange(ptxn, {
+            prefix: ["acme"], start: ["acme", 1700000050],
+        }), ["b", "c"]);
+        assert.deepEqual(pdbi.valuesRange(ptxn, {
+            prefix: ["acme"], end: ["acme", 1700000100, 7], reverse: true,
+        }), ["b", "a"]);
+        assert.equal(pdbi.getCount(ptxn, { prefix: ["acme"] }), 3);
+        assert.deepEqual(pdbi.valuesRange(ptxn, { prefix: ["nope"] }), []);
+        assert.deepEqual(pdbi.keysRange(ptxn, {
+            start: ["acme", 1700000100], end: ["acmf"],
+        }), [["acme", 1700000100, 7], ["acme", 1700000100, 8]]);
+
+        const cursor = ptxn.openCursor(pdbi);
+        const found = cursor.seekGE(["acmf"]);
+        assert.deepEqual(found.key, ["acmf", 1, 1]);
+        cursor.close();
+        ptxn.abort();
+
+        // query() кодирует ключи тем же способом
+        const [rows] = await env.query([{
+            dbi: pdbi,
+            mode: MDBX_Param.queryMode.get,
+            item: [{ key: ["zeta", 1, 1] }],
+        }]);
+        assert.deepEqual(rows[0].key, ["zeta", 1, 1]);
+        assert.equal(rows[0].value.toString(), "e");
+
+        // продолжения элемента (экранированный 0x00, остаток BigInt)
+        // не попадают в префикс более короткого кортежа
+        const xtxn = env.startWrite();
+        const cont = xtxn.createMap({ name: "cont", keyFlag: tupleFlag });
+        const b60 = 2n ** 60n;
+        for (const k of [["a"], ["a", 1], ["a\u0000b"], ["a\u0000b", 1],
+            [b60], [b60, 1], [b60 + 1n], [b60 + 255n, 1], ["b"]]) {
+            cont.put(xtxn, k, "v");
+        }
+        assert.deepEqual(cont.keysRange(xtxn, { prefix: ["a"] }), [["a"], ["a", 1]]);
+        assert.deepEqual(cont.keysRange(xtxn, { prefix: ["a"], reverse: true }),
+            [["a", 1], ["a"]]);
+        assert.deepEqual(cont.keysRange(xtxn, { prefix: ["a\u0000b"] }),
+            [["a\u0000b"], ["a\u0000b", 1]]);
+        assert.deepEqual(cont.keysRange(xtxn, { prefix: [b60] }), [[b60], [b60, 1]]);
+        assert.deepEqual(cont.keysRange(xtxn, { prefix: [b60], reverse: true }),
+            [[b60, 1], [b60]]);
+        assert.equal(cont.getCount(xtxn, { prefix: [b60 + 1n] }), 1);
+        assert.equal(cont.delRange(xtxn, { prefix: ["a"] }), 2);
+        assert.equal(cont.delRange(xtxn, { prefix: [b60] }), 2);
+        assert.deepEqual(cont.keys(xtxn), [["a\u0000b"], ["a\u0000b", 1],
+            ["b"], [b60 + 1n], [b60 + 255n, 1]]);
+        xtxn.commit();
+
+        // prefix для обычных ключей - байтовый
+        const btxn = env.startWrite();
+        const plain = btxn.createMap({ name: "plain", keyFlag: MDBX_Param.keyFlag.string });
+        for (const k of ["user:1", "user:2", "users", "user;"]) {
+            plain.put(btxn, k, k);
+        }
+        assert.deepEqual(plain.keysRange(btxn, { prefix: "user:" }), ["user:1", "user:2"]);
+        btxn.commit();
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("tuple-keys test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
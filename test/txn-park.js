@@ -0,0 +1,84 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { setTimeout: sleep } = require("node:timers/promises");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, valueFlag } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-txn-park-"));
+    const env = new MDBX_Env();
+    try {
+        // читатель и писатель в одном потоке
+        env.openSync({ path: dir, maxDbi: 4, flags: MDBX_Param.envFlag.nostickythreads });
+
+        let txn = env.startWrite();
+        const names = txn.createMap({
+            name: "names", keyFlag: keyFlag.string, valueFlag: valueFlag.string,
+        });
+        names.put(txn, "a", "1");
+        assert.throws(() => txn.park(), /read transaction/);
+        txn.commit();
+
+        txn = env.startRead();
+        const view = names.getView(txn, "a");
+        assert.equal(txn.isParked(), false);
+        txn.park();
+        assert.equal(txn.isParked(), true);
+        // страницы припаркованного снимка могут быть переиспользованы
+        assert.equal(view.buffer.byteLength, 0);
+        assert.throws(() => names.get(txn, "a"));
+        assert.equal(txn.unpark(), false);
+        assert.equal(txn.isParked(), false);
+        assert.equal(names.get(txn, "a"), "1");
+        assert.equal(txn.unpark(), false);
+
+        // autoUnpark: первое обращение распарковывает само
+        txn.park({ autoUnpark: true });
+        assert.equal(names.get(txn, "a"), "1");
+        assert.equal(txn.isParked(), false);
+        txn.abort();
+        assert.throws(() => txn.park(), /completed/);
+
+        assert.throws(() => env.startRead({ autoParkMs: 0 }), /autoParkMs/);
+        txn = env.startRead({ autoParkMs: 20 });
+        await sleep(80);
+        assert.equal(txn.isParked(), true);
+        // писатель не ждет припаркованного читателя
+        const writer = env.startWrite();
+        names.put(writer, "b", "2");
+        writer.commit();
+        assert.equal(names.get(txn, "a"), "1");
+        assert.equal(names.has(txn, "b"), false);
+        assert.equal(txn.isParked(), false);
+        txn.abort();
+
+        // шаги курсора тоже считаются обращением
+        txn = env.startRead({ autoParkMs: 40 });
+        const cursor = txn.openCursor(names);
+        assert.equal(cursor.first().key, "a");
+        for (let i = 0; i < 10; ++i) {
+            await sleep(5);
+            cursor.next();
+            assert.equal(txn.isParked(), false);
+        }
+        cursor.close();
+        txn.abort();
+        // таймер останавливается после завершения транзакции
+        await sleep(50);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("txn-park test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,95 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, valueFlag } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-value-cache-"));
+    const env = new MDBX_Env();
+    try {
+        env.openSync({ path: dir, maxDbi: 4 });
+
+        let txn = env.startWrite();
+        const dbi = txn.createMap({
+            name: "flags",
+            keyFlag: keyFlag.string,
+            valueFlag: valueFlag.string,
+            cache: { maxBytes: 4096 },
+        });
+        const raw = txn.createMap({ name: "raw", cache: true });
+        assert.equal(txn.createMap({ name: "plain" }).cacheStats(), undefined);
+        assert.throws(() => txn.openMap({ name: "flags", cache: "yes" }), /cache/);
+        assert.throws(() => txn.openMap({
+            name: "flags", cache: { maxBytes: 0 },
+        }), /maxBytes/);
+        dbi.put(txn, "feature", "on");
+        raw.put(txn, Buffer.from("k"), Buffer.from("v"));
+        // пишущая транзакция кэш не трогает
+        assert.equal(dbi.get(txn, "feature"), "on");
+        assert.equal(dbi.cacheStats().misses, 0);
+        txn.commit();
+
+        let rtxn = env.startRead();
+        assert.equal(dbi.get(rtxn, "feature"), "on");
+        assert.equal(dbi.get(rtxn, "missing"), undefined);
+        rtxn.abort();
+
+        // новый снимок без изменений таблицы - попадания
+        rtxn = env.startRead();
+        for (let i = 0; i < 100; ++i) {
+            assert.equal(dbi.get(rtxn, "feature"), "on");
+            assert.equal(dbi.get(rtxn, "missing"), undefined);
+        }
+        const first = raw.get(rtxn, Buffer.from("k"));
+        first[0] = 0x78;
+        assert.deepEqual(raw.get(rtxn, Buffer.from("k")), Buffer.from("v"));
+        rtxn.abort();
+
+        let stats = dbi.cacheStats();
+        assert.equal(stats.misses, 2);
+        assert.equal(stats.hits, 200);
+        assert.equal(stats.entries, 2);
+        assert.equal(stats.maxBytes, 4096);
+        assert.equal(raw.cacheStats().hits, 1);
+
+        // фиксация в таблицу делает записи устаревшими
+        txn = env.startWrite();
+        dbi.put(txn, "feature", "off");
+        txn.commit();
+        rtxn = env.startRead();
+        assert.equal(dbi.get(rtxn, "feature"), "off");
+        assert.equal(dbi.get(rtxn, "missing"), undefined);
+        rtxn.abort();
+        assert.equal(dbi.cacheStats().misses, 4);
+
+        // размер ограничен байтами
+        txn = env.startWrite();
+        for (let i = 0; i < 200; ++i) {
+            dbi.put(txn, `key-${i}`, "x".repeat(64));
+        }
+        txn.commit();
+        rtxn = env.startRead();
+        for (let i = 0; i < 200; ++i) {
+            assert.equal(dbi.get(rtxn, `key-${i}`), "x".repeat(64));
+        }
+        rtxn.abort();
+        stats = dbi.cacheStats();
+        assert.ok(stats.bytes <= 4096);
+        assert.ok(stats.entries < 200);
+    } finally {
+        env.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("value-cache test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});
@@ -0,0 +1,79 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { spawnSync } = require("node:child_process");
+const { MDBX_Env } = require("../lib/nativemou.js");
+
+const timeoutMs = 10_000;
+
+function openEnvironment(dbPath) {
+    const env = new MDBX_Env();
+    env.openSync({ path: dbPath, maxDbi: 8 });
+    return env;
+}
+
+if (process.argv.includes("--child")) {
+    // фиксация из другого процесса
+    const env = openEnvironment(process.argv[process.argv.indexOf("--child") + 1]);
+    const txn = env.startWrite();
+    txn.createMap("values").put(txn, "from-child", "1");
+    txn.commit();
+    env.closeSync();
+    process.exit(0);
+}
+
+function nextCommit(env, predicate = () => true) {
+    return new Promise((resolve, reject) => {
+        const timer = setTimeout(() => {
+            stop();
+            reject(new Error(`no commit notification within ${timeoutMs} ms`));
+        }, timeoutMs);
+        const stop = env.watch((txnId) => {
+            if (predicate(txnId)) {
+                clearTimeout(timer);
+                stop();
+                resolve(txnId);
+            }
+        }, { intervalMs: 10 });
+    });
+}
+
+async function main() {
+    const root = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-watch-"));
+    const dbPath = path.join(root, "db");
+    const env = openEnvironment(dbPath);
+    try {
+        let txn = env.startWrite();
+        const dbi = txn.createMap("values");
+        txn.commit();
+
+        const own = nextCommit(env);
+        txn = env.startWrite();
+        dbi.put(txn, "local", "1");
+        txn.commit();
+        const localTxnId = await own;
+        assert.ok(localTxnId > 0);
+
+        const foreign = nextCommit(env, (txnId) => txnId > localTxnId);
+        const child = spawnSync(process.execPath, [__filename, "--child", dbPath], {
+            encoding: "utf8",
+        });
+        assert.equal(child.status, 0, child.stderr || child.stdout);
+        assert.ok(await foreign > localTxnId);
+
+        // close() останавливает оставленных наблюдателей
+        env.watch(() => {});
+    } finally {
+        await env.close();
+        fs.rmSync(root, { recursive: true, force: true });
+    }
+    console.log("watch() reports local and cross-process commits");
+}
+
+main().catch((error) => {
+    console.error(error);
+    process.exit(1);
+});
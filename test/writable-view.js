@@ -0,0 +1,103 @@
+"use strict";
+
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { MDBX_Env, MDBX_Param } = require("../lib/nativemou.js");
+
+const { keyFlag, keyMode, valueMode } = MDBX_Param;
+
+async function main() {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mdbxmou-writable-view-"));
+    const env = new MDBX_Env();
+    try {
+        // читатель и писатель в одном потоке
+        env.openSync({ path: dir, maxDbi: 4, flags: MDBX_Param.envFlag.nostickythreads });
+
+        let txn = env.startWrite();
+        const records = txn.createMap({ name: "records", keyFlag: keyFlag.string });
+        const dups = txn.createMap({
+            name: "dups", keyMode: keyMode.ordinal, valueMode: valueMode.multiOrdinal,
+        });
+        const record = Buffer.alloc(16);
+        record.writeUInt32LE(7, 0);
+        record.write("name", 4);
+        records.put(txn, "r1", record);
+        // большое значение живет в отдельных страницах
+        records.put(txn, "big", Buffer.alloc(64 * 1024, 3));
+        txn.commit();
+
+        const reader = env.startRead();
+        txn = env.startWrite();
+        const view = records.getWritableView(txn, "r1");
+        assert.ok(view instanceof DataView);
+        assert.equal(view.byteLength, 16);
+        assert.equal(view.getUint32(0, true), 7);
+        view.setUint32(0, view.getUint32(0, true) + 1, true);
+        assert.equal(records.get(txn, "r1").readUInt32LE(0), 8);
+        assert.equal(records.get(txn, "r1").toString("latin1", 4, 8), "name");
+        // читатель видит старую версию до фиксации
+        assert.equal(records.get(reader, "r1").readUInt32LE(0), 7);
+
+        const big = records.getWritableView(txn, "big");
+        assert.equal(big.byteLength, 64 * 1024);
+        assert.equal(big.getUint8(0), 3);
+        assert.equal(big.getUint8(big.byteLength - 1), 3);
+        big.setUint8(100, 9);
+
+        // следующая запись отсоединяет виды
+        assert.equal(records.getWritableView(txn, "none"), undefined);
+        records.put(txn, "r2", Buffer.from("x"));
+        assert.equal(view.buffer.byteLength, 0);
+        assert.equal(big.buffer.byteLength, 0);
+        assert.throws(() => dups.getWritableView(txn, 1), /multi-value/);
+        txn.commit();
+        reader.abort();
+
+        txn = env.startRead();
+        assert.equal(records.get(txn, "r1").readUInt32LE(0), 8);
+        const stored = records.get(txn, "big");
+        assert.equal(stored.length, 64 * 1024);
+        assert.equal(stored[100], 9);
+        assert.equal(stored[101], 3);
+        assert.throws(() => records.getWritableView(txn, "r1"), /write transaction/);
+        txn.abort();
+
+        txn = env.startWrite();
+        records.getWritableView(txn, "r1").setUint32(0, 0, true);
+        txn.abort();
+        txn = env.startRead();
+        assert.equal(records.get(txn, "r1").readUInt32LE(0), 8);
+        txn.abort();
+    } finally {
+        env.closeSync();
+    }
+
+    // журнал со значениями не увидел бы байты, записанные через вид
+    const logged = new MDBX_Env();
+    try {
+        logged.openSync({ path: path.join(dir, "logged"), maxDbi: 4,
+            changelog: { values: true } });
+        const txn = logged.startWrite();
+        const records = txn.createMap({ name: "records", keyFlag: keyFlag.string });
+        records.put(txn, "r1", Buffer.alloc(8, 1));
+        assert.throws(() => records.getWritableView(txn, "r1"),
+            /getWritableView: not supported while the change log records values/);
+        assert.deepEqual(records.get(txn, "r1"), Buffer.alloc(8, 1));
+        txn.commit();
+        const { changes } = await logged.readChanges();
+        assert.deepEqual(changes.map((c) => `${c.op}:${c.key}`), ["put:r1"]);
+        assert.deepEqual(changes[0].value, Buffer.alloc(8, 1));
+    } finally {
+        logged.closeSync();
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+}
+
+main().then(() => {
+    console.log("writable-view test passed");
+}).catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+});